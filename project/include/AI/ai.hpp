@@ -6,6 +6,7 @@
 #define GENETIC_AI_HPP
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <ctime>
 #include <iostream>
@@ -21,8 +22,7 @@ namespace genetic_tetris {
  */
 class AI : public Observer {
 public:
-    explicit AI(Tetris &tetris)
-        : tetris_(tetris), generator_(RandomNumberGenerator::getInstance()) {}
+    explicit AI(Tetris &tetris) : tetris_(tetris) {}
     ~AI() override = default;
 
     /// Tells algorithm to finish
@@ -34,9 +34,9 @@ public:
 
 protected:
     Tetris &tetris_;
-    RandomNumberGenerator &generator_;
 
-    volatile bool finish_ = false;
+    /// Read by worker threads, so they can stop as soon as possible
+    std::atomic<bool> finish_{false};
 };
 
 }  // namespace genetic_tetris
@@ -5,12 +5,21 @@
 #ifndef GENETIC_TETRIS_EVOLUTIONARY_ALGO_HPP
 #define GENETIC_TETRIS_EVOLUTIONARY_ALGO_HPP
 
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include "ai.hpp"
+#include "fitness_cache.hpp"
 #include "genome.hpp"
+#include "seq_lock.hpp"
+#include "task_scheduler.hpp"
 
 namespace genetic_tetris {
 
@@ -28,15 +37,116 @@ public:
         PLAY,
         EVOLVE,
     };
+    /// Specifies how scores of one genome from games with different seeds are combined
+    enum class Aggregation {
+        MEAN,
+        MEDIAN,
+        MIN,
+    };
+    /// Counters and phase timers of evolve(). Times and counts refer to the last generation.
+    struct Stats {
+        int generation = 0;
+        /// Pieces placed in evaluation games
+        std::uint64_t pieces = 0;
+        /// Candidate placements scored by generateBestMove() in evaluation games
+        std::uint64_t placements = 0;
+        /// Placements divided by evaluation wall time
+        double placements_per_second = 0.0;
+        /// Wall time of generation phases
+        double selection_seconds = 0.0;
+        double mutation_seconds = 0.0;
+        double evaluation_seconds = 0.0;
+        /// Counts since evolve() started
+        std::uint64_t total_pieces = 0;
+        std::uint64_t total_placements = 0;
+    };
+    /// State of evolution published after every generation for other threads
+    struct Progress {
+        int generation = 0;
+        /// Mean fitness of the generation
+        float mean_fitness = 0.0f;
+        /**
+         * Best genome of the generation as plain values. Progress is built every generation, and
+         * a Genome member would draw random weights and take an id from the evolution thread.
+         */
+        struct Best {
+            long id = 0;
+            float score = 0.0f;
+            float rows_cleared = 0.0f;
+            float max_height = 0.0f;
+            float cumulative_height = 0.0f;
+            float relative_height = 0.0f;
+            float holes = 0.0f;
+            float roughness = 0.0f;
+        } best;
+        /// Scheduler statistics of the generation's evaluation
+        TaskScheduler::BatchStats evaluation;
+        /// Genomes of the generation which were not simulated thanks to the fitness cache
+        std::size_t cache_hits = 0;
+        std::size_t cache_lookups = 0;
+        /// Cache statistics since evolve() started
+        std::size_t cache_total_hits = 0;
+        std::size_t cache_total_lookups = 0;
+        /// Config::fixed_seeds of the run, without it only duplicates within a generation hit
+        bool fixed_seeds = false;
+        Stats stats;
+    };
+    /// Compact state of a game played in evaluation, published for the mosaic view
+    struct BoardSnapshot {
+        /// Occupancy of visible rows, bottom row first
+        std::array<Tetris::Row, Tetris::GRID_VISIBLE_HEIGHT> rows;
+        /// False once the game stopped, e.g. it ended or was cut by racing
+        bool playing;
+    };
+    /// Most genomes whose games are published for the mosaic view
+    static const std::size_t MOSAIC_BOARDS = 100;
+    /// Parameters of the algorithm, read when play() or evolve() starts
+    struct Config {
+        /// Population size, at least 2
+        std::size_t pop_size = 50;
+        /// Rate at which genome attributes will be mutated
+        float mutation_rate = 0.1f;
+        /// Strength of the singular mutation
+        float mutation_step = 0.2f;
+        /// Number of moves simulated in evaluation function
+        int moves_to_simulate = 400;
+        /// Number of threads evaluating genomes, 0 means one per hardware thread
+        unsigned int threads = 0;
+        /// Number of games played by every genome in a generation. All genomes get the same seeds.
+        int seeds_per_generation = 4;
+        /// Specifies how scores of games played by one genome are combined into its fitness
+        Aggregation aggregation = Aggregation::MEAN;
+        /**
+         * If true, seeds are drawn once per evolve() instead of every generation. Genomes
+         * surviving unchanged to the next generation then hit the fitness cache and are not
+         * simulated again. Cached fitness is keyed by seeds, so otherwise only duplicates within
+         * one generation hit the cache.
+         */
+        bool fixed_seeds = false;
+        /**
+         * Number of successive halving rounds in evaluation. All genomes play a short round,
+         * then racing_cut of the worst ones stops and the rest play twice as long in the next
+         * round. Cut genomes get their score extrapolated to the full game. 1 disables racing.
+         * Fitness cache is not used while racing.
+         */
+        int racing_rounds = 1;
+        /// Fraction of genomes cut after every racing round
+        float racing_cut = 0.5f;
+        /// evolve() stops after this many generations, 0 means it runs until finish()
+        int max_generations = 0;
+        /// File where genomes will be located
+        std::string genomes_file = "res/genomes.json";
+    };
     /**
-     * Generates best possible move taking into account tetris state and genome attributes
+     * Generates best possible move taking into account tetris state and genome attributes.
+     * Candidate moves are applied to tetris and undone, so its state is the same on return.
      * @param genome - genome used to calculate fitness function
      * @param tetris - tetris object for which function will generate the best move
      * @return best move generated for current state of tetris
      */
     static Move generateBestMove(const Genome& genome, Tetris& tetris);
 
-    explicit EvolutionaryAlgo(Tetris& tetris) : AI(tetris) {}
+    explicit EvolutionaryAlgo(Tetris& tetris);
 
     /**
      * Runs the algorithm
@@ -59,12 +169,43 @@ public:
     std::string getInfo() const;
     /// Returns current best genome
     Genome getBest() const;
+    /// Returns statistics of the last finished generation
+    Stats getStats() const;
+    /**
+     * Returns snapshot of the last finished generation. Doesn't lock, can be called from
+     * any thread while evolve() is running, e.g. every frame by the GUI.
+     */
+    Progress getProgress() const { return progress_.load(); }
+    /**
+     * Enables publishing of board snapshots. While enabled, the first game of each of the first
+     * MOSAIC_BOARDS genomes is published after every move. Safe to call from any thread.
+     */
+    void setMosaicEnabled(bool enabled);
+    bool isMosaicEnabled() const;
+    /// Returns number of genomes whose games are published
+    std::size_t getMosaicBoardCount() const;
+    /// Returns last published game of given genome. Doesn't lock, safe to call from any thread.
+    BoardSnapshot getBoardSnapshot(std::size_t genome) const;
+    /// Formats generation number, mean fitness, evaluation and best genome as multi-line text
+    static std::string formatInfo(const Progress& progress);
+    /// Formats statistics as multi-line text, used by GUI and headless runs
+    static std::string formatStats(const Stats& stats);
+
+    /**
+     * Evaluates pop once with current config, without selection and mutation, e.g. to measure
+     * evaluation in benchmarks. Fitness cache is cleared first, so every genome is simulated.
+     * Must not be called while evolve() is running.
+     * @return scheduler statistics of the evaluation
+     */
+    TaskScheduler::BatchStats evaluateOnce(std::vector<Genome>& pop);
 
     /// Saves genomes to file
     void save();
 
     /// Specifies generation number used to play against the player
     void setPlayingGeneration(int value);
+    void setConfig(const Config& config) { config_ = config; }
+    const Config& getConfig() const { return config_; }
     /// Returns the number of generations available in genome file
     int getAvailableGenerations() const { return generation_bests_.size(); }
     /**
@@ -80,18 +221,6 @@ private:
         START,
     };
 
-    /// Population size
-    const std::size_t POP_SIZE = 50;
-    /// Rate at which genome attributes will be mutated
-    const float MUTATION_RATE = 0.1f;
-    /// Strength of the singular mutation
-    const float MUTATION_STEP = 0.2f;
-    /// Number of moves simulated in evaluation function
-    const int MOVES_TO_SIMULATE = 400;
-
-    /// File where genomes will be located
-    const std::string GENOMES_FILE = "res/genomes.json";
-
     /// Saves given set of genomes to specified file
     static void saveToJSON(const std::string& file, std::vector<Genome>& genomes);
     /// Loads set of genomes from specified file
@@ -112,6 +241,22 @@ private:
     std::vector<Genome> mutation(std::vector<Genome>& selected);
     /// Evaluates the next population
     void evaluation(std::vector<Genome>& next_pop);
+    /// Combines scores of games played by one genome, may reorder them
+    static float aggregate(std::vector<unsigned int>& scores, Aggregation aggregation);
+    /**
+     * Continues a game with given genome. Safe to call from many threads for different games.
+     * @param snapshot if not null, game is published there after every move
+     * @return number of moves played, less than moves if the game ended or algorithm was stopped
+     */
+    int simulate(const Genome& genome, Tetris& tetris, int moves,
+                 SeqLock<BoardSnapshot>* snapshot = nullptr) const;
+
+    /**
+     * Publishes progress of the generation which has just been evaluated, posts
+     * GENERATION_FINISHED and returns the progress
+     */
+    Progress publishProgress(double selection_seconds, double mutation_seconds,
+                             double evaluation_seconds);
 
     /// Mutates one genome
     void mutate(Genome& genome);
@@ -142,6 +287,37 @@ private:
     /// Tells whether algorithm is in the process of smoothly dropping a tetromino
     bool is_dropping_smoothly_;
 
+    /// Algorithm parameters
+    Config config_;
+    /// Seeds played in the last generation
+    std::vector<std::uint64_t> seeds_;
+    /// Schedules evaluation games on worker threads, exists while evolve() is running
+    std::unique_ptr<TaskScheduler> scheduler_;
+    /// Scheduler statistics of the last evaluated generation
+    TaskScheduler::BatchStats evaluation_stats_;
+    /// Statistics of the last finished generation, used only by evolve() thread
+    Stats stats_;
+    /// Pieces and placements of current generation. Every game accumulates its counts
+    /// locally and adds them here once it is over.
+    mutable std::atomic<std::uint64_t> generation_pieces_{0};
+    mutable std::atomic<std::uint64_t> generation_placements_{0};
+
+    /// Fitness of genomes already evaluated on current seeds
+    FitnessCache fitness_cache_;
+    /// Genomes in the last generation which were not simulated thanks to the cache
+    std::size_t cache_hits_ = 0;
+    std::size_t cache_lookups_ = 0;
+    /// Cache statistics of the whole evolve() run
+    std::size_t cache_total_hits_ = 0;
+    std::size_t cache_total_lookups_ = 0;
+
+    /// Last published progress, the only evolve() state read by other threads
+    SeqLock<Progress> progress_;
+    /// Games published for the mosaic view, one per genome. SeqLock can't be moved, so
+    /// every one is allocated separately.
+    std::vector<std::unique_ptr<SeqLock<BoardSnapshot>>> snapshots_;
+    std::atomic<bool> mosaic_enabled_{false};
+
     /// Generation playing againt the player. Specified in GUI.
     int playing_generation_;
     /// Generations available in loaded JSON file containing genomes
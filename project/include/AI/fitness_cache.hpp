@@ -0,0 +1,55 @@
+/*
+ * Author: Damian Kolaska
+ */
+
+#ifndef GENETIC_TETRIS_FITNESS_CACHE_HPP
+#define GENETIC_TETRIS_FITNESS_CACHE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "genome.hpp"
+
+namespace genetic_tetris {
+
+/**
+ * Remembers fitness of genomes evaluated on a given set of seeds.
+ * Genome's id and score are not part of the key, only its weights.
+ */
+class FitnessCache {
+public:
+    /// Identifies evaluation of genome weights on a set of seeds
+    struct Key {
+        std::array<float, 6> weights;
+        std::uint64_t seeds_hash;
+
+        bool operator==(const Key& rhs) const {
+            return weights == rhs.weights && seeds_hash == rhs.seeds_hash;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    /// Cache is cleared when it grows above this number of entries
+    static const std::size_t MAX_ENTRIES = 100000;
+
+    static Key makeKey(const Genome& genome, std::uint64_t seeds_hash);
+    static std::uint64_t hashSeeds(const std::vector<std::uint64_t>& seeds);
+
+    /// Looks up fitness for key, returns false if it has not been inserted yet
+    bool find(const Key& key, float& fitness) const;
+    void insert(const Key& key, float fitness);
+    void clear() { entries_.clear(); }
+
+private:
+    std::unordered_map<Key, float, KeyHash> entries_;
+};
+
+}  // namespace genetic_tetris
+
+#endif  // GENETIC_TETRIS_FITNESS_CACHE_HPP
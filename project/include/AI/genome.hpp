@@ -39,6 +39,17 @@ public:
           roughness(roughness) {
         id = next_id++;
     }
+    /// Constructs copy of a genome with given id and score, doesn't take a new id
+    Genome(long id, float score, float rowsCleared, float maxHeight, float cumulativeHeight,
+           float relativeHeight, float holes, float roughness)
+        : id(id),
+          rows_cleared(rowsCleared),
+          max_height(maxHeight),
+          cumulative_height(cumulativeHeight),
+          relative_height(relativeHeight),
+          holes(holes),
+          roughness(roughness),
+          score(score) {}
     bool operator==(const Genome& rhs) const {
         return rows_cleared == rhs.rows_cleared && max_height == rhs.max_height &&
                cumulative_height == rhs.cumulative_height &&
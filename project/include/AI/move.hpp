@@ -20,6 +20,7 @@ public:
     inline static const int MIN_ROT = 0;
     inline static const int MAX_ROT = 3;
 
+    /// Constructs move dropping tetromino straight down from its spawn position
     Move();
     Move(int moveX, int rotations);
 
@@ -32,6 +33,13 @@ public:
      * @param hard_drop if true will perform hard drop and calculate tetris properties
      */
     void apply(Tetris &tetris, bool hard_drop = true);
+    /**
+     * Performs the move with a hard drop so it can be reverted with Tetris::undo()
+     * @param tetris tetris on which move will be applied
+     * @param journal filled with data needed to revert the move
+     * @return false if the move doesn't fit in the grid (tetris is not changed), true otherwise
+     */
+    bool apply(Tetris &tetris, Tetris::Journal &journal);
 
     int getMoveX() const { return move_x_; }
     int getRotation() const { return rotations_; }
@@ -42,12 +50,19 @@ public:
     int getHoles() const { return holes_; }
     int getRoughness() const { return roughness_; }
 
+    /**
+     * Calculates grid properties by scanning the whole grid. Slower than the properties kept
+     * by Move::apply(), used as a reference in tests and benchmarks.
+     */
+    void calculateGridProperties(const Tetris::Grid &grid);
+
 private:
 
     static int calculateHoles(const Tetris::Grid &grid);
 
-    /// Calculates grid properties after Move::apply
-    void calculateGridProperties(const Tetris::Grid &grid);
+    /// Same as calculateGridProperties(const Tetris::Grid&), but uses column heights and holes
+    /// kept by tetris, O(grid width)
+    void calculateGridProperties(const Tetris &tetris);
 
     /// Move in x direction
     int move_x_;
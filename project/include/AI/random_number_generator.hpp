@@ -5,21 +5,41 @@
 #ifndef GENETIC_TETRIS_RANDOM_NUMBER_GENERATOR_HPP
 #define GENETIC_TETRIS_RANDOM_NUMBER_GENERATOR_HPP
 
-#include <ctime>
-#include <random>
+#include <atomic>
+#include <cstdint>
+
+#include "tetris/pcg32.hpp"
 
 namespace genetic_tetris {
 
 /**
- * Random number generator using Mersenne Twister and std::uniform_real_distribution
+ * Per-thread random number generator.
+ *
+ * Every thread gets its own PCG32 engine, so it can be used from many threads without locking.
+ * All engines share one master seed and differ by stream, which is assigned in order
+ * in which threads first use the generator. Satisfies UniformRandomBitGenerator.
  */
 class RandomNumberGenerator {
 public:
+    using result_type = Pcg32::result_type;
+
+    /// Returns generator of the calling thread
     static RandomNumberGenerator& getInstance();
+    /**
+     * Sets master seed and restarts stream numbering. Calling thread's generator is reseeded
+     * with the first stream, generators of other threads are reseeded on their next
+     * getInstance() call.
+     */
+    static void setMasterSeed(std::uint64_t seed);
 
     RandomNumberGenerator(const RandomNumberGenerator&) = delete;
     RandomNumberGenerator& operator=(const RandomNumberGenerator&) = delete;
 
+    static constexpr result_type min() { return Pcg32::min(); }
+    static constexpr result_type max() { return Pcg32::max(); }
+    result_type operator()() { return engine_(); }
+
+    /// Returns random value from range [0, 1)
     float random_0_1();
 
     /**
@@ -30,17 +50,27 @@ public:
      */
     template <int a, int b>
     float random() {
-        static std::uniform_real_distribution<float> dis(a, b);
-        return dis(generator_);
+        return (float)a + (float)(b - a) * random_0_1();
     }
 
+    /// Returns random 64-bit value, e.g. to seed genetic_tetris::Tetris
+    std::uint64_t nextSeed();
+
 private:
     RandomNumberGenerator();
 
-    std::mt19937 generator_;
-    std::uniform_real_distribution<float> dis_0_1;
+    /// Seeds engine with master seed and next free stream
+    void reseed();
+
+    inline static std::atomic<std::uint64_t> master_seed_{0};
+    /// Incremented on every setMasterSeed(), so other threads know they have to reseed
+    inline static std::atomic<unsigned int> master_seed_version_{0};
+    inline static std::atomic<std::uint64_t> next_stream_{0};
+
+    Pcg32 engine_;
+    unsigned int seed_version_ = 0;
 };
 
 }  // namespace genetic_tetris
 
-#endif  // GENETIC_TETRIS_GUI_UTILS_HPP
+#endif  // GENETIC_TETRIS_RANDOM_NUMBER_GENERATOR_HPP
@@ -0,0 +1,82 @@
+/*
+ * Author: Damian Kolaska
+ */
+
+#ifndef GENETIC_TETRIS_SHOWCASE_PLAYER_HPP
+#define GENETIC_TETRIS_SHOWCASE_PLAYER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "evolutionary_algo.hpp"
+#include "tetris/tetris.hpp"
+#include "triple_buffer.hpp"
+
+namespace genetic_tetris {
+
+/**
+ * Plays a demo game with the current best genome of evolution on its own thread.
+ *
+ * Boards are published through a triple buffer, so the GUI can draw the newest one
+ * every frame without waiting for move generation. Game is restarted once it's over.
+ */
+class ShowcasePlayer {
+public:
+    /// Board state published after every move
+    struct Frame {
+        Tetris::Grid grid;
+        unsigned int score;
+    };
+
+    /// Default playback rate, one move per frame at 60 FPS
+    static constexpr double DEFAULT_MOVES_PER_SECOND = 60.0;
+    /// Lower rates are raised to this one
+    static constexpr double MIN_MOVES_PER_SECOND = 0.1;
+
+    explicit ShowcasePlayer(const EvolutionaryAlgo& ai);
+    ~ShowcasePlayer();
+
+    ShowcasePlayer(const ShowcasePlayer&) = delete;
+    ShowcasePlayer& operator=(const ShowcasePlayer&) = delete;
+
+    /// Starts playing a new game on the background thread
+    void start();
+    /// Stops the background thread and clears the board
+    void stop();
+
+    /// Number of moves played per second. Can be changed while playing.
+    void setMovesPerSecond(double value) { moves_per_second_ = value; }
+    double getMovesPerSecond() const { return moves_per_second_; }
+
+    /**
+     * Takes the newest board, call from the GUI thread only.
+     * @return false if no move was played since the last call
+     */
+    bool consume() { return frames_.consume(); }
+    /// Board taken by the last consume()
+    const Frame& getFrame() const { return frames_.readBuffer(); }
+
+private:
+    void run();
+    /// Publishes current state of tetris_
+    void publish();
+
+    const EvolutionaryAlgo& ai_;
+    /// Game played by the background thread, not accessed by other threads while it's running
+    Tetris tetris_;
+    TripleBuffer<Frame> frames_;
+
+    std::atomic<double> moves_per_second_{DEFAULT_MOVES_PER_SECOND};
+
+    std::thread thread_;
+    std::mutex m_;
+    /// Wakes up the thread when it's being stopped
+    std::condition_variable stop_cond_;
+    bool stop_ = false;
+};
+
+}  // namespace genetic_tetris
+
+#endif  // GENETIC_TETRIS_SHOWCASE_PLAYER_HPP
@@ -0,0 +1,92 @@
+/*
+ * Author: Damian Kolaska
+ */
+
+#ifndef GENETIC_TETRIS_TASK_SCHEDULER_HPP
+#define GENETIC_TETRIS_TASK_SCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace genetic_tetris {
+
+/**
+ * Work-stealing scheduler running batches of independent tasks on a fixed set of threads.
+ *
+ * Every worker owns a deque of task indices. A batch is split evenly between the deques,
+ * each worker takes tasks from the front of its own deque and, once it runs dry,
+ * steals from the back of the other ones. Tasks of uneven length (e.g. games ending early)
+ * are thus rebalanced at the end of a batch instead of leaving threads idle.
+ */
+class TaskScheduler {
+public:
+    /// Task receives its index in the batch
+    using Task = std::function<void(std::size_t)>;
+
+    /// Statistics of the most recent batch
+    struct BatchStats {
+        /// Time from the start of run() until the last task finished
+        double wall_seconds = 0.0;
+        /// Time spent in tasks divided by (threads * wall time), in range [0, 1]
+        double utilization = 0.0;
+        /// Number of tasks executed by a worker other than the one they were assigned to
+        std::size_t steals = 0;
+    };
+
+    /// threads equal to 0 means one thread per hardware thread
+    explicit TaskScheduler(unsigned int threads = 0);
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /// Runs task(i) for every i in [0, count) on worker threads and waits for all of them.
+    void run(std::size_t count, const Task& task);
+
+    BatchStats getLastBatchStats() const { return stats_; }
+    unsigned int getThreadCount() const { return (unsigned int)workers_.size(); }
+    /// Returns number of workers a scheduler constructed with given threads would have
+    static unsigned int resolveThreadCount(unsigned int threads);
+
+private:
+    /// Task indices owned by one worker
+    struct WorkQueue {
+        std::mutex m;
+        std::deque<std::size_t> tasks;
+    };
+
+    void workerLoop(std::size_t id);
+    /// Takes a task from the worker's own queue or steals one, returns false if there is none
+    bool takeTask(std::size_t id, std::size_t& task);
+
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    /// Nanoseconds each worker spent executing tasks in current batch
+    std::vector<long long> busy_ns_;
+
+    std::mutex m_;
+    /// Wakes up workers when a new batch is available or the scheduler is being destroyed
+    std::condition_variable work_cond_;
+    /// Wakes up run() when all workers are done with current batch
+    std::condition_variable done_cond_;
+
+    const Task* task_ = nullptr;
+    std::atomic<std::size_t> steals_{0};
+    /// Incremented for every batch, so workers know there is something new to do
+    unsigned long batch_ = 0;
+    std::size_t idle_workers_ = 0;
+    bool stop_ = false;
+
+    BatchStats stats_;
+};
+
+}  // namespace genetic_tetris
+
+#endif  // GENETIC_TETRIS_TASK_SCHEDULER_HPP
@@ -14,6 +14,7 @@
 
 #include "AI/ai.hpp"
 #include "AI/evolutionary_algo.hpp"
+#include "AI/showcase_player.hpp"
 #include "event_manager.hpp"
 #include "gui/gui.hpp"
 #include "sound_manager.hpp"
@@ -58,6 +59,7 @@ private:
     Tetris tetris_ai_;
 
     EvolutionaryAlgo ai_;
+    ShowcasePlayer showcase_;
 
     GUI gui_;
 
@@ -67,6 +69,8 @@ private:
 
     State state_;
     Controller* active_controller_;
+    /// Dropped events already reported, see EventManager::getDroppedCount()
+    std::size_t reported_dropped_events_ = 0;
 };
 
 }  // namespace genetic_tetris
@@ -27,7 +27,7 @@ public:
     virtual void finish() = 0;
 
     virtual void handleSfmlEvent(const sf::Event& e) = 0;
-    virtual void handleCustomEvent(EventType e) = 0;
+    virtual void handleCustomEvent(const Event& event) = 0;
 
 protected:
     GUI& gui_;
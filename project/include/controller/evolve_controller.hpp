@@ -6,7 +6,7 @@
 #define GENETIC_TETRIS_EVOLVE_CONTROLLER_HPP
 
 #include <AI/evolutionary_algo.hpp>
-#include <tetris/tetris.hpp>
+#include <AI/showcase_player.hpp>
 
 #include "controller.hpp"
 
@@ -19,7 +19,7 @@ class EvolveController : public Controller {
 public:
     enum class State { START, STOP } state_ = State::STOP;
 
-    EvolveController(Tetris& tetris_ai, EvolutionaryAlgo& ai, GUI& gui);
+    EvolveController(ShowcasePlayer& showcase, EvolutionaryAlgo& ai, GUI& gui);
 
     void update() override;
     void start() override;
@@ -27,10 +27,11 @@ public:
     void finish() override;
 
     void handleSfmlEvent(const sf::Event&) override {}
-    void handleCustomEvent(EventType e) override;
+    void handleCustomEvent(const Event& event) override;
 
 private:
-    Tetris& tetris_ai_;
+    /// Demo game with the best genome, played on its own thread
+    ShowcasePlayer& showcase_;
     EvolutionaryAlgo& ai_;
 
     std::thread ai_thread_;
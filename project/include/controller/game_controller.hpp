@@ -30,7 +30,7 @@ public:
     void finish() override;
 
     void handleSfmlEvent(const sf::Event& event) override;
-    void handleCustomEvent(EventType e) override;
+    void handleCustomEvent(const Event& event) override;
 
 private:
     /// Interval between next AI moves (when player has finished)
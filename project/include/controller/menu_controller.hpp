@@ -24,7 +24,7 @@ public:
     void finish() override {}
 
     void handleSfmlEvent(const sf::Event&) override {}
-    void handleCustomEvent(EventType) override {}
+    void handleCustomEvent(const Event&) override {}
 };
 
 }  // namespace genetic_tetris
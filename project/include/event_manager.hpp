@@ -5,8 +5,11 @@
 #ifndef GENETIC_TETRIS_EVENT_MANAGER_HPP
 #define GENETIC_TETRIS_EVENT_MANAGER_HPP
 
-#include <list>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 
+#include "mpsc_queue.hpp"
 #include "utils.hpp"
 
 namespace genetic_tetris {
@@ -27,13 +30,30 @@ enum class EventType {
     GENERATION_OUT_OF_BOUNDS,
     GAME_STARTED,
     GAME_START_FAILED,
+    /// Evolution finished a generation, payload is its number
+    GENERATION_FINISHED,
+    MOSAIC_BUTTON_CLICKED,
+};
+
+/**
+ * Event with optional payload, e.g. generation number
+ */
+struct Event {
+    EventType type;
+    std::int64_t payload = 0;
 };
 
 /**
  * Simple event manager.
+ * Events can be added from any thread without locking, they are polled by the GUI thread.
+ * Events are queued only while a consumer is attached, so headless runs (e.g. evolve_cli)
+ * don't fill the queue with events nobody reads.
  */
 class EventManager {
 public:
+    /// Maximum number of events waiting to be polled
+    static const std::size_t CAPACITY = 256;
+
     static EventManager& getInstance() {
         static EventManager instance;
         return instance;
@@ -42,21 +62,43 @@ public:
     EventManager(const EventManager&) = delete;
     EventManager operator=(const EventManager&) = delete;
 
-    /// Returns event from the front and removes it
-    EventType pollEvent() {
-        EventType e = events.front();
-        events.pop_front();
-        return e;
+    /**
+     * Tells whether some thread polls events. Call before the consumer starts polling,
+     * events added while no consumer is attached are ignored.
+     */
+    void setConsumerAttached(bool attached) { consumer_attached_ = attached; }
+
+    /**
+     * Takes the oldest event. Must be called by one thread only.
+     * @return false if there are no events
+     */
+    bool pollEvent(Event& event) { return events_.pop(event); }
+
+    /**
+     * Adds event, safe to call from any thread.
+     * @return false if the event wasn't queued, because no consumer is attached or the queue
+     * is full. The latter is counted by getDroppedCount().
+     */
+    bool addEvent(EventType type, std::int64_t payload = 0) {
+        if (!consumer_attached_) {
+            return false;
+        }
+        if (!events_.push(Event{type, payload})) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
     }
 
-    void addEvent(const EventType& e) { events.push_back(e); }
-    bool isEmpty() const { return events.empty(); }
-    void removeEvent(EventType event) { events.remove(event); }
+    /// Returns number of events dropped because the consumer didn't keep up
+    std::size_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
 
 private:
     EventManager() = default;
 
-    std::list<EventType> events;
+    MpscQueue<Event, CAPACITY> events_;
+    std::atomic<bool> consumer_attached_{false};
+    std::atomic<std::size_t> dropped_{0};
 };
 
 }  // namespace genetic_tetris
@@ -30,13 +30,13 @@ public:
     };
 
     GUI(int width, int height, int fps, Tetris& human_tetris, Tetris& ai_tetris,
-        EvolutionaryAlgo& ai);
+        EvolutionaryAlgo& ai, ShowcasePlayer& showcase);
     void update();
     void draw();
     void close();
     bool pollEvent(sf::Event& event);
     void handleSfmlEvent(const sf::Event& event);
-    void handleCustomEvent(EventType event);
+    void handleCustomEvent(const Event& event);
     void reset();
     void setActiveScreen(ScreenType screen_type);
     Screen* getActiveScreen();
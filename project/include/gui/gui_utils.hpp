@@ -8,8 +8,8 @@
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
 #include <SFML/Graphics.hpp>
-#include <deque>
-#include <map>
+#include <array>
+#include <cstdint>
 #include <vector>
 
 #include "sound_manager.hpp"
@@ -19,10 +19,12 @@
  */
 namespace genetic_tetris {
 
-const std::map<Tetromino::Color, sf::Color>& getTetrominoColorMap();
+/// Returns colors used to draw squares, indexed by Tetromino::Color
+const std::array<sf::Color, Tetromino::COLORS_COUNT>& getTetrominoColors();
 
 /**
  * Class used to display tetris grid and next tetromino panel.
+ * Remembers which color every tile has and recolors only tiles which changed.
  */
 class TetrisBoard {
 public:
@@ -38,23 +40,82 @@ public:
     TetrisBoard(const sf::Vector2f& position, const sf::Vector2i& board_tile_count,
                 const TileProperties& tile_prop);
     void setState(const Tetris::Grid& tetris_grid);
-    void setTetrominoQueue(const std::deque<Tetromino>& queue);
+    /// Same as setState(const Tetris::Grid&), but does nothing if game revision hasn't changed
+    void setState(const Tetris& tetris);
+    void setTetrominoQueue(const TetrominoGenerator::QueueView& queue);
     void draw(sf::RenderWindow& window);
+    /// Clears finished state and makes next setState(const Tetris&) update the board
     void reset();
 
     bool isStateFinished() const;
     void setStateFinished(bool finished);
 
 private:
-    using Board = std::vector<std::vector<sf::RectangleShape>>;
+    /// Number of vertices of one tile quad
+    static const int TILE_VERTICES_ = 4;
+    /// Tetris revisions start above it
+    static const std::uint64_t NO_REVISION_ = 0;
 
     const sf::Color FINISHED_HUE_CHANGE_ = sf::Color(50, 50, 50, 0);
 
+    /// Colors tile with finished tint applied if needed, y = 0 is the top row of the board
+    void setTileColor(int x, int y, Tetromino::Color color);
+    /// Recolors tiles whose color in next_tile_colors_ differs from tile_colors_
+    void applyNextTileColors();
+
     bool state_finished_;
-    Board board_;
+    /// Color of every tile, row by row from the top
+    std::vector<Tetromino::Color> tile_colors_;
+    /// Colors being composed for the next update, kept to avoid allocations
+    std::vector<Tetromino::Color> next_tile_colors_;
+    /// Revision of the game shown by setState(const Tetris&)
+    std::uint64_t revision_;
+    Tetris::Grid grid_;
+    /// All tiles as quads, drawn with a single draw call. Only colors change after construction.
+    sf::VertexArray tiles_;
     sf::Vector2i board_tile_count_;
 };
 
+/**
+ * Grid of small boards showing many games at once, e.g. every genome during evaluation.
+ * Boards show only which squares are taken. All of them are drawn with a single draw call
+ * and setBoard() recolors only squares which changed.
+ */
+class MosaicBoard {
+public:
+    /// Occupancy of visible rows of a game, bottom row first
+    using Rows = std::array<Tetris::Row, Tetris::GRID_VISIBLE_HEIGHT>;
+
+    /**
+     * @param board_count number of boards, laid out in rows of columns boards
+     * @param tile_size size of a single square
+     * @param gap space between boards
+     */
+    MosaicBoard(const sf::Vector2f& position, std::size_t board_count, std::size_t columns,
+                float tile_size, float gap);
+    /// Shows game on given board, board of a game which stopped is dimmed
+    void setBoard(std::size_t board, const Rows& rows, bool playing);
+    void draw(sf::RenderWindow& window);
+    /// Empties all boards
+    void reset();
+
+private:
+    static const int TILE_VERTICES_ = 4;
+
+    const sf::Color FILLED_COLOR_ = sf::Color(0x708090ff);
+    const sf::Color STOPPED_HUE_CHANGE_ = sf::Color(50, 50, 50, 0);
+
+    /// Colors square of a board, y = 0 is the bottom row
+    void setTileColor(std::size_t board, int x, int y, bool filled, bool playing);
+
+    std::size_t board_count_;
+    /// Shown state of every board
+    std::vector<Rows> rows_;
+    std::vector<bool> playing_;
+    /// Squares of all boards, board after board, each one row by row from the bottom
+    sf::VertexArray tiles_;
+};
+
 /**
  * Custom button class.
  * Provides with only most basic functionalities like custom click handlers, hue change on clicked.
@@ -6,6 +6,7 @@
 #define GENETIC_TETRIS_EVOLVE_SCREEN_HPP
 
 #include <AI/evolutionary_algo.hpp>
+#include <AI/showcase_player.hpp>
 #include <gui/gui_utils.hpp>
 
 #include "screen.hpp"
@@ -14,37 +15,56 @@ namespace genetic_tetris {
 
 class EvolveScreen : public Screen {
 public:
-    EvolveScreen(sf::RenderWindow& window, EvolutionaryAlgo& ai, const Tetris& tetris_ai);
+    EvolveScreen(sf::RenderWindow& window, EvolutionaryAlgo& ai, ShowcasePlayer& showcase);
 
     void update() override;
     void draw() override;
     void reset() override;
     void handleSfmlEvent(const sf::Event& event) override;
-    void handleCustomEvent(EventType event) override;
+    void handleCustomEvent(const Event& event) override;
 
     // Helper functions for creating GUI elements
     void createInfo();
+    void createStats();
     void createBackButton();
     void createStartStopButton();
     void createSaveButton();
+    void createMosaicButton();
+    void createShowcaseControls();
     void createStatus();
 
+    /// Refreshes info and stats texts from the last published progress
+    void updateInfo();
+
 private:
     /// How long GUI status should be displayed
     const sf::Time STATUS_PERSISTENCE_ = sf::seconds(1.0f);
 
     EvolutionaryAlgo& ai_;
-    const Tetris& tetris_ai_;
+    /// Source of boards drawn on board_ai_
+    ShowcasePlayer& showcase_;
+    /// Range of showcase game speed, in moves per second
+    const sf::Vector2i SHOWCASE_SPEED_BOUNDS_ = sf::Vector2i(1, 99);
 
     TetrisBoard board_ai_;
+    /// Games of the whole population, drawn instead of board_ai_ if mosaic mode is enabled
+    MosaicBoard mosaic_;
 
     /// Evolutionary algorithm info
     sf::Text info_;
+    /// Evolution counters and phase timers
+    sf::Text stats_;
+    /// Score of the showcase game
+    sf::Text showcase_score_;
+    sf::Text showcase_speed_text_;
+    /// Moves per second of the showcase game
+    IncDecDialog showcase_speed_dialog_;
     /// GUI status
     sf::Text status_;
     Button start_stop_button_;
     Button back_button_;
     Button save_button_;
+    Button mosaic_button_;
 
     sf::Clock status_clock_;
 };
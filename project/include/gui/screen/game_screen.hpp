@@ -21,7 +21,7 @@ public:
     void draw() override;
     void reset() override;
     void handleSfmlEvent(const sf::Event& event) override;
-    void handleCustomEvent(EventType event) override;
+    void handleCustomEvent(const Event& event) override;
 
     int getPlayingGeneration() const;
     void setAvailableGenerations(int value);
@@ -17,7 +17,7 @@ public:
     void draw() override;
     void reset() override {}
     void handleSfmlEvent(const sf::Event& event) override;
-    void handleCustomEvent(EventType) override {}
+    void handleCustomEvent(const Event&) override {}
 
 private:
     void createPlayButton();
@@ -0,0 +1,93 @@
+/*
+ * Author: Damian Kolaska
+ */
+
+#ifndef GENETIC_TETRIS_MPSC_QUEUE_HPP
+#define GENETIC_TETRIS_MPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace genetic_tetris {
+
+/**
+ * Bounded lock-free queue for many producer threads and one consumer thread.
+ *
+ * Based on Dmitry Vyukov's bounded MPMC queue. Every cell has a sequence number telling
+ * whether it's free for the producer which reserved it or ready for the consumer.
+ * Memory is allocated once, push() and pop() never allocate.
+ * @tparam T copy assignable type of elements
+ * @tparam CAPACITY maximum number of elements, power of two
+ */
+template <typename T, std::size_t CAPACITY>
+class MpscQueue {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0,
+                  "MpscQueue capacity must be a power of two");
+
+public:
+    MpscQueue() {
+        for (std::size_t i = 0; i < CAPACITY; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /// Adds value at the end, safe to call from any thread. Returns false if the queue is full.
+    bool push(const T& value) {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells_[pos & MASK];
+            std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto diff = (std::intptr_t)sequence - (std::intptr_t)pos;
+            if (diff == 0) {
+                // cell is free, try to reserve it
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // consumer hasn't taken the value written CAPACITY pushes ago
+                return false;
+            } else {
+                // another producer reserved this cell first
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Takes value from the front, must be called by one thread only. Returns false if empty.
+    bool pop(T& value) {
+        Cell& cell = cells_[head_ & MASK];
+        std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != head_ + 1) {
+            return false;
+        }
+        value = cell.value;
+        cell.sequence.store(head_ + CAPACITY, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+private:
+    static const std::size_t MASK = CAPACITY - 1;
+    /// Keeps counters modified by different threads in separate cache lines
+    static const std::size_t CACHE_LINE = 64;
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::array<Cell, CAPACITY> cells_;
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail_{0};
+    alignas(CACHE_LINE) std::size_t head_ = 0;
+};
+
+}  // namespace genetic_tetris
+
+#endif  // GENETIC_TETRIS_MPSC_QUEUE_HPP
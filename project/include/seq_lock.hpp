@@ -0,0 +1,76 @@
+/*
+ * Author: Damian Kolaska
+ */
+
+#ifndef GENETIC_TETRIS_SEQ_LOCK_HPP
+#define GENETIC_TETRIS_SEQ_LOCK_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace genetic_tetris {
+
+/**
+ * Sequence lock publishing a value from one writer thread to any number of readers.
+ *
+ * Readers never block the writer and never take a lock. A read which overlaps a write
+ * is detected by the sequence number and retried, so it's cheap as long as writes are rare
+ * (e.g. once per generation). Value is kept in atomic words, so concurrent access
+ * is not a data race.
+ * @tparam T trivially copyable, default constructible type of the published value
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires trivially copyable T");
+
+public:
+    explicit SeqLock(const T& value) { store(value); }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    /// Publishes new value. Must not be called by two threads at once.
+    void store(const T& value) {
+        std::array<std::uint64_t, WORDS> buffer{};
+        std::memcpy(buffer.data(), &value, sizeof(T));
+        std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+        // odd sequence tells readers a write is in progress
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            words_[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /// Returns the last published value. Safe to call from any thread.
+    T load() const {
+        std::array<std::uint64_t, WORDS> buffer;
+        std::uint64_t seq_before, seq_after;
+        do {
+            seq_before = seq_.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < WORDS; ++i) {
+                buffer[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            seq_after = seq_.load(std::memory_order_relaxed);
+        } while ((seq_before & 1u) != 0 || seq_before != seq_after);
+        T value;
+        std::memcpy(static_cast<void*>(&value), buffer.data(), sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr std::size_t WORDS = (sizeof(T) + sizeof(std::uint64_t) - 1) /
+                                         sizeof(std::uint64_t);
+
+    std::atomic<std::uint64_t> seq_{0};
+    std::array<std::atomic<std::uint64_t>, WORDS> words_{};
+};
+
+}  // namespace genetic_tetris
+
+#endif  // GENETIC_TETRIS_SEQ_LOCK_HPP
@@ -0,0 +1,65 @@
+/*
+ * Author: Rafal Kulus
+ */
+
+#ifndef PCG32_HPP
+#define PCG32_HPP
+
+#include <cstdint>
+#include <limits>
+
+namespace genetic_tetris {
+
+/**
+ * Small, fast and seedable pseudo random number generator (PCG-XSH-RR).
+ * https://www.pcg-random.org/
+ * Satisfies UniformRandomBitGenerator, so it can be used with <random> and <algorithm>.
+ */
+class Pcg32 {
+public:
+    using result_type = std::uint32_t;
+
+    /// Generators with the same seed but different streams produce independent sequences
+    explicit Pcg32(std::uint64_t seed = 0, std::uint64_t stream = 0)
+        : state_(0), increment_((stream << 1u) | 1u) {
+        (*this)();
+        state_ += seed;
+        (*this)();
+    }
+
+    static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        std::uint64_t old_state = state_;
+        state_ = old_state * MULTIPLIER + increment_;
+        auto xorshifted = static_cast<std::uint32_t>(((old_state >> 18u) ^ old_state) >> 27u);
+        auto rot = static_cast<std::uint32_t>(old_state >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    /// Returns uniformly distributed number in range [0, bound). bound must be positive.
+    std::uint32_t bounded(std::uint32_t bound) {
+        // https://arxiv.org/abs/1805.10941
+        std::uint64_t m = static_cast<std::uint64_t>((*this)()) * bound;
+        auto low = static_cast<std::uint32_t>(m);
+        if (low < bound) {
+            std::uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                m = static_cast<std::uint64_t>((*this)()) * bound;
+                low = static_cast<std::uint32_t>(m);
+            }
+        }
+        return static_cast<std::uint32_t>(m >> 32u);
+    }
+
+private:
+    static const std::uint64_t MULTIPLIER = 6364136223846793005ULL;
+
+    std::uint64_t state_;
+    std::uint64_t increment_;
+};
+
+}  // namespace genetic_tetris
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ * Author: Rafal Kulus
+ */
+
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+namespace genetic_tetris {
+
+/**
+ * Double-ended queue with fixed capacity, stored inline (never allocates).
+ */
+template <typename T, std::size_t N>
+class RingBuffer {
+public:
+    class ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator(const RingBuffer* buffer, std::size_t index)
+            : buffer_(buffer), index_(index) {}
+        reference operator*() const { return (*buffer_)[index_]; }
+        pointer operator->() const { return &(*buffer_)[index_]; }
+        ConstIterator& operator++() {
+            ++index_;
+            return *this;
+        }
+        ConstIterator operator++(int) {
+            ConstIterator old(*this);
+            ++index_;
+            return old;
+        }
+        bool operator==(const ConstIterator& rhs) const { return index_ == rhs.index_; }
+        bool operator!=(const ConstIterator& rhs) const { return index_ != rhs.index_; }
+
+    private:
+        const RingBuffer* buffer_;
+        std::size_t index_;
+    };
+
+    /// Non-owning view of first elements of the buffer. Invalidated by modifying the buffer.
+    class View {
+    public:
+        View(const RingBuffer* buffer, std::size_t size) : buffer_(buffer), size_(size) {}
+        ConstIterator begin() const { return ConstIterator(buffer_, 0); }
+        ConstIterator end() const { return ConstIterator(buffer_, size_); }
+        std::size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        const T& front() const { return (*buffer_)[0]; }
+        const T& operator[](std::size_t i) const { return (*buffer_)[i]; }
+
+    private:
+        const RingBuffer* buffer_;
+        std::size_t size_;
+    };
+
+    static constexpr std::size_t capacity() { return N; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const T& front() const { return items_[head_]; }
+    const T& operator[](std::size_t i) const { return items_[(head_ + i) % N]; }
+
+    void push_back(const T& item) {
+        if (size_ == N) {
+            throw std::length_error("RingBuffer is full");
+        }
+        items_[(head_ + size_) % N] = item;
+        ++size_;
+    }
+
+    void push_front(const T& item) {
+        if (size_ == N) {
+            throw std::length_error("RingBuffer is full");
+        }
+        head_ = (head_ + N - 1) % N;
+        items_[head_] = item;
+        ++size_;
+    }
+
+    void pop_front() {
+        head_ = (head_ + 1) % N;
+        --size_;
+    }
+
+    void pop_back() { --size_; }
+
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, size_); }
+
+    /// Returns view of at most count first elements
+    View view(std::size_t count) const { return View(this, count < size_ ? count : size_); }
+
+private:
+    std::array<T, N> items_{};
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+};
+
+}  // namespace genetic_tetris
+
+#endif
@@ -5,6 +5,8 @@
 #ifndef TETRIS_HPP
 #define TETRIS_HPP
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -27,6 +29,12 @@ public:
     static const int GRID_VISIBLE_HEIGHT = 20;
     static const int GRID_FULL_HEIGHT = 40;
 
+    /// Occupancy of a single grid row, bit x is set if column x is taken
+    using Row = std::uint16_t;
+    static_assert(GRID_WIDTH <= 16, "Grid row must fit in Tetris::Row");
+    static constexpr Row FULL_ROW = (1u << GRID_WIDTH) - 1;
+    using ColorRow = std::array<Tetromino::Color, GRID_WIDTH>;
+
     static constexpr Position TETROMINO_INITIAL_POS = {(GRID_WIDTH / 2) - 2,
                                                        (GRID_FULL_HEIGHT / 2) - 1};
 
@@ -46,8 +54,60 @@ public:
     /// Per dropped line
     static const int SCORE_HARD_DROP = 2;
 
-    /// disable_drop_scores can be set to true to disable score for soft and hard drops e.g. for AI
-    explicit Tetris(bool disable_drop_scores = false);
+    /// Read-only view of locked squares (without active tetromino), valid while the game exists
+    class GridView {
+    public:
+        GridView(const ColorRow* colors, const Row* occupancy)
+            : colors_(colors), occupancy_(occupancy) {}
+        /// Allows grid[y][x] indexing, same as Grid
+        const ColorRow& operator[](int y) const { return colors_[y]; }
+        Row getOccupancy(int y) const { return occupancy_[y]; }
+        bool isOccupied(int x, int y) const { return (occupancy_[y] & (1u << x)) != 0; }
+        static constexpr int width() { return GRID_WIDTH; }
+        static constexpr int height() { return GRID_FULL_HEIGHT; }
+
+    private:
+        const ColorRow* colors_;
+        const Row* occupancy_;
+    };
+
+    /// Most lines that can be cleared with a single tetromino
+    static const int MAX_CLEARED_ROWS = 4;
+
+    /**
+     * State changed by Tetris::applyPlacement(), used by Tetris::undo() to revert it.
+     * Keeps only the rows touched by the placement, so it can be reused without allocations.
+     */
+    struct Journal {
+        Tetromino tetromino;
+        Position tetromino_position;
+        TetrominoGenerator::State generator_state;
+        /// Position at which tetromino has been locked
+        Position placed_position;
+        int placed_rotation;
+        /// True if tetromino has been locked and a new one has been spawned
+        bool locked;
+        /// Indices of cleared rows (in ascending order, before clearing) and their colors
+        std::array<int, MAX_CLEARED_ROWS> cleared_rows;
+        std::array<ColorRow, MAX_CLEARED_ROWS> cleared_colors;
+        unsigned int cleared_rows_count;
+        std::array<int, GRID_WIDTH> column_heights;
+        int holes;
+        bool is_finished;
+        unsigned int score;
+        unsigned int level;
+        unsigned int level_progress;
+        double level_speed;
+        unsigned int last_cleared_rows;
+    };
+
+    /**
+     * @param disable_drop_scores can be set to true to disable score for soft and hard drops
+     * e.g. for AI
+     * @param seed seed of tetromino generator, games with the same seed get the same tetrominoes
+     */
+    explicit Tetris(bool disable_drop_scores = false,
+                    std::uint64_t seed = TetrominoGenerator::randomSeed());
 
     /**
      * @param is_soft_drop indicates if the current tick was caused by a soft drop input
@@ -61,9 +121,42 @@ public:
     void hardDrop(bool tick_after_drop = true);
     void rotateCW();
     void rotateCCW();
+    /// Kicks only if the kick system supports 180 degree rotations (see WallKicks::KickSystem)
+    void rotate180();
+    /**
+     * Drops active tetromino straight down in given rotation and column and locks it in place,
+     * without simulating shifts and rotations. Landing row is computed from column heights.
+     * Assumes the column is reachable from the spawn position, which holds unless the stack
+     * has already grown into the spawn area.
+     * @param rotation target rotation of active tetromino, taken modulo 4 (e.g. -1 is 3)
+     * @param column x position of active tetromino
+     * @return false if tetromino doesn't fit in the grid at given column (nothing is changed),
+     * true otherwise
+     */
+    bool place(int rotation, int column);
+    /**
+     * Same as Tetris::place(), but records everything needed to revert the placement.
+     * @param journal filled in only when placement succeeded
+     * @return false if tetromino doesn't fit in the grid at given column (nothing is changed),
+     * true otherwise
+     */
+    bool applyPlacement(int rotation, int column, Journal& journal);
+    /**
+     * Reverts placement recorded by Tetris::applyPlacement(). Placements must be undone in
+     * reverse order.
+     */
+    void undo(const Journal& journal);
     /// Returns grid without current tetromino and ghost piece (used in AI calculations)
     Grid getRawGrid() const;
+    /// Same as getRawGrid(), but doesn't copy anything
+    GridView getGridView() const;
+    /// Returns visible part of the grid with ghost piece and current tetromino
     Grid getDisplayGrid() const;
+    /**
+     * Same as getDisplayGrid(), but writes to a caller-owned grid, which doesn't allocate
+     * once the grid has the right size
+     */
+    void getDisplayGrid(Grid& out) const;
     /// Returns grid as a string. Used for testing.
     std::string toString() const;
     bool isFinished() const;
@@ -72,7 +165,20 @@ public:
     unsigned int getLevelProgress() const;
     double getLevelSpeed() const;
     unsigned int getLastTickClearedRowsCount() const;
-    std::deque<Tetromino> getTetrominoQueue() const;
+    /// Returns height of each column (index of the row above its highest square)
+    const std::array<int, GRID_WIDTH>& getColumnHeights() const;
+    /// Returns number of empty squares with a locked square directly above them
+    int getHoles() const;
+    /// Returns number of locked squares in given row
+    int getRowFillCount(int row) const;
+    /// Returns view of next tetrominoes, valid until the game is modified
+    TetrominoGenerator::QueueView getTetrominoQueue() const;
+    /**
+     * Returns number which changes whenever the game changes, e.g. active tetromino moves.
+     * Different games never share revisions, copies get a revision of their own too,
+     * so redrawing can be skipped if it's the same.
+     */
+    std::uint64_t getRevision() const;
 
 protected:
     virtual void generateTetromino();
@@ -81,17 +187,35 @@ private:
     /// Checks if specified position is valid for current tetromino
     bool isValidPosition(Position tetromino_position) const;
     Position getHardDropPosition() const;
-    void clearLines();
+    /**
+     * Locks active tetromino at its current position, clears lines and spawns a new tetromino
+     * @return false if tetromino sticks out of the grid and couldn't be locked, true otherwise
+     */
+    bool lockTetromino(Journal* journal = nullptr);
+    /// Places tetromino as in Tetris::place(), journal is optional
+    bool placeTetromino(int rotation, int column, Journal* journal);
+    /// Clears full rows among rows [from_row, to_row] and moves rows above them down
+    void clearLines(int from_row, int to_row, Journal* journal = nullptr);
+    /// Returns number of holes between rows [from, to] and the rows above them
+    int countHoles(int from, int to) const;
     void addClearedLinesScore();
     void addProgress();
     /// https://tetris.fandom.com/wiki/Tetris_Worlds#Gravity
     void calculateLevelSpeed();
-    void rotate(bool ccw);
+    /// Rotates clockwise by given number of 90 degree turns, in range [1, 3]
+    void rotate(int quarter_turns);
 
     TetrominoGenerator generator_;
     Tetromino tetromino_;
     Position tetromino_position_;
-    Grid grid_;
+    /// Bitboard used for collision tests and line clears
+    std::array<Row, GRID_FULL_HEIGHT> occupancy_;
+    /// Colors of locked squares, only needed for rendering
+    std::array<ColorRow, GRID_FULL_HEIGHT> colors_;
+    /// Index of the row above the highest locked square in each column
+    std::array<int, GRID_WIDTH> column_heights_;
+    /// Kept up to date as tetrominoes lock and lines clear
+    int holes_;
 
     bool is_finished_;
 
@@ -103,6 +227,32 @@ private:
     unsigned int cleared_rows_;
 
     bool drop_scores_disabled_;
+
+    /**
+     * Revision counter which starts from a new base whenever it's constructed, copied
+     * or assigned, so copies of a game don't share revisions with the original
+     */
+    class Revision {
+    public:
+        Revision() : value_(nextBase()) {}
+        Revision(const Revision&) : value_(nextBase()) {}
+        Revision& operator=(const Revision&) {
+            value_ = nextBase();
+            return *this;
+        }
+        Revision& operator++() {
+            ++value_;
+            return *this;
+        }
+        std::uint64_t get() const { return value_; }
+
+    private:
+        static std::uint64_t nextBase();
+
+        std::uint64_t value_;
+    };
+
+    Revision revision_;
 };
 
 class ObservableTetris : public Tetris, public Subject {
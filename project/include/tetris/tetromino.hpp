@@ -5,31 +5,34 @@
 #ifndef TETROMINO_HPP
 #define TETROMINO_HPP
 
-#include <string>
+#include <array>
+#include <type_traits>
 #include <utility>
-#include <vector>
 
 namespace genetic_tetris {
 
 /**
  * Class representing active (playable) tetromino.
+ * It is only a handle {shape, rotation}, squares of every shape in every rotation are
+ * stored in tables computed at compile time.
  */
 class Tetromino {
 public:
-    using Pivot = std::pair<double, double>;
     using Square = std::pair<int, int>;
-    using Squares = std::vector<Square>;
-    using Rotations = std::vector<Squares>;
+    using Squares = std::array<Square, 4>;
+    using Rotations = std::array<Squares, 4>;
 
     enum class Color { EMPTY, CYAN, YELLOW, PURPLE, GREEN, RED, BLUE, ORANGE, GHOST };
+    /// Number of Color values, allows colors to index arrays
+    static const int COLORS_COUNT = 9;
     enum class Shape { NO_SHAPE, I, O, T, S, Z, J, L };
 
-    static Squares rotate(const Squares& squares, const Pivot& pivot, double rad);
+    static const int ROTATIONS_COUNT = 4;
 
-    Tetromino();
-    Tetromino(Color color, Shape shape, Pivot pivot, const Squares& squares);
-    Tetromino(const Tetromino& tetromino) = default;
-    Tetromino& operator=(const Tetromino& tetromino) = default;
+    constexpr Tetromino() : shape_(Shape::NO_SHAPE), current_rotation_(0) {}
+    /// rotation should be in range [0, 3]
+    constexpr explicit Tetromino(Shape shape, int rotation = 0)
+        : shape_(shape), current_rotation_(rotation) {}
     void rotateCW();
     void rotateCCW();
     Color getColor() const;
@@ -38,12 +41,13 @@ public:
     int getCurrentRotation() const;
 
 private:
-    Color color_;
     Shape shape_;
-    Rotations rotations_;
     int current_rotation_;
 };
 
+static_assert(std::is_trivially_copyable<Tetromino>::value,
+              "Tetromino should be cheap to copy, it is copied around by AI");
+
 }  // namespace genetic_tetris
 
-#endif
\ No newline at end of file
+#endif
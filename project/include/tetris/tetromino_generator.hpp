@@ -5,9 +5,12 @@
 #ifndef TETROMINO_GENERATOR_HPP
 #define TETROMINO_GENERATOR_HPP
 
-#include <deque>
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 
+#include "tetris/pcg32.hpp"
+#include "tetris/ring_buffer.hpp"
 #include "tetris/tetromino.hpp"
 
 namespace genetic_tetris {
@@ -16,18 +19,42 @@ class TetrominoGenerator {
 public:
     /// Number of next tetrominoes player can preview.
     static const unsigned int QUEUE_LENGTH = 4;
+    /// Enough for two full bags
+    static const std::size_t QUEUE_CAPACITY = 14;
+
+    using Queue = RingBuffer<Tetromino, QUEUE_CAPACITY>;
+    using QueueView = Queue::View;
+
+    /// Part of generator state changed by getNextTetromino()
+    struct State {
+        Pcg32 random;
+        std::size_t queue_size;
+    };
     /// Returns all types of tetrominoes available in the game.
-    static const std::vector<Tetromino>& getTetrominoes();
+    static const std::array<Tetromino, 7>& getTetrominoes();
+
+    /// Returns non-deterministic seed, used when game doesn't have to be reproducible
+    static std::uint64_t randomSeed();
 
-    TetrominoGenerator();
+    /// Generators with the same seed produce the same sequence of tetrominoes
+    explicit TetrominoGenerator(std::uint64_t seed = randomSeed());
     Tetromino getNextTetromino();
-    std::deque<Tetromino> getQueue() const;
+    State getState() const;
+    /**
+     * Reverts getNextTetromino()
+     * @param tetromino tetromino returned by getNextTetromino(), it is put back in the queue
+     * @param state state from before getNextTetromino() call
+     */
+    void returnTetromino(const Tetromino& tetromino, const State& state);
+    /// Returns view of next QUEUE_LENGTH tetrominoes, valid until the generator is modified
+    QueueView getQueue() const;
 
 private:
     /// Uses 7-bag Random Generator. https://tetris.fandom.com/wiki/Random_Generator
     void generateTetrominoes();
 
-    std::deque<Tetromino> queue_;
+    Pcg32 random_;
+    Queue queue_;
 };
 
 }  // namespace genetic_tetris
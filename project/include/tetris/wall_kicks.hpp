@@ -5,16 +5,68 @@
 #ifndef WALL_KICKS_HPP
 #define WALL_KICKS_HPP
 
-#include <vector>
+#include <cstddef>
+#include <utility>
 
 /**
  * https://tetris.fandom.com/wiki/SRS#Wall_Kicks
  */
 namespace genetic_tetris::WallKicks {
 
+using Offset = std::pair<int, int>;
+
+/// Non-owning view of offsets (in test order) from a static wall kick table
+class Kicks {
+public:
+    constexpr Kicks() : data_(nullptr), size_(0) {}
+    constexpr Kicks(const Offset* data, std::size_t size) : data_(data), size_(size) {}
+
+    constexpr const Offset* begin() const { return data_; }
+    constexpr const Offset* end() const { return data_ + size_; }
+    constexpr std::size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr const Offset& operator[](std::size_t i) const { return data_[i]; }
+
+private:
+    const Offset* data_;
+    std::size_t size_;
+};
+
+/// Tetrominoes sharing the same wall kick data. O tetromino doesn't kick at all.
+enum class PieceClass { GENERIC, I };
+
+/**
+ * Kick systems. Each one provides kicks for 90 degree rotations and 180 degree rotations
+ * (from and to being opposite states). from and to should be in range [0, 3], empty Kicks are
+ * returned for unsupported rotations.
+ */
+/// Standard SRS, 180 degree rotations don't kick
+struct Srs {
+    static Kicks get(PieceClass piece_class, int from, int to);
+};
+
+/// SRS with symmetric I kicks and 180 degree kicks, as in TETR.IO
+struct SrsPlus {
+    static Kicks get(PieceClass piece_class, int from, int to);
+};
+
+/// ARS-like kicks on SRS rotation states: try right, then left, I tetromino doesn't kick
+struct Ars {
+    static Kicks get(PieceClass piece_class, int from, int to);
+};
+
+/// Kick system used by the game, chosen at compile time (KICK_SYSTEM option in CMake)
+#if defined(GENETIC_TETRIS_KICK_SYSTEM_SRS_PLUS)
+using KickSystem = SrsPlus;
+#elif defined(GENETIC_TETRIS_KICK_SYSTEM_ARS)
+using KickSystem = Ars;
+#else
+using KickSystem = Srs;
+#endif
+
 /// Wall kicks for every tetromino except for O and I. from and to should be in range [0, 3]
-std::vector<std::pair<int, int> > getGenericWallKicks(int from, int to);
-std::vector<std::pair<int, int> > getITetrominoWallKicks(int from, int to);
+Kicks getGenericWallKicks(int from, int to);
+Kicks getITetrominoWallKicks(int from, int to);
 
 }  // namespace genetic_tetris::WallKicks
 
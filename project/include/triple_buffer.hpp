@@ -0,0 +1,62 @@
+/*
+ * Author: Damian Kolaska
+ */
+
+#ifndef GENETIC_TETRIS_TRIPLE_BUFFER_HPP
+#define GENETIC_TETRIS_TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace genetic_tetris {
+
+/**
+ * Wait-free triple buffer passing the newest value from one producer thread to one consumer.
+ *
+ * Producer fills writeBuffer() and calls publish(), consumer calls consume() and reads
+ * readBuffer(). Both sides own one buffer each and swap it with the middle one, so neither
+ * ever waits for the other. Values published between two consume() calls are skipped,
+ * only the newest one is read.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T& value) : buffers_{value, value, value} {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /// Buffer owned by the producer, valid until publish()
+    T& writeBuffer() { return buffers_[back_]; }
+    /// Makes writeBuffer() available to the consumer and hands producer a new one
+    void publish() {
+        back_ = middle_.exchange(back_ | DIRTY, std::memory_order_acq_rel) & INDEX;
+    }
+
+    /// Takes the newest published value, returns false if nothing was published since last call
+    bool consume() {
+        if ((middle_.load(std::memory_order_relaxed) & DIRTY) == 0) {
+            return false;
+        }
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    /// Buffer owned by the consumer, valid until consume()
+    const T& readBuffer() const { return buffers_[front_]; }
+
+private:
+    static const std::uint8_t INDEX = 0x3u;
+    /// Set in middle_ when it holds a value the consumer hasn't seen yet
+    static const std::uint8_t DIRTY = 0x4u;
+
+    std::array<T, 3> buffers_;
+    std::uint8_t back_ = 0;
+    std::atomic<std::uint8_t> middle_{1};
+    std::uint8_t front_ = 2;
+};
+
+}  // namespace genetic_tetris
+
+#endif  // GENETIC_TETRIS_TRIPLE_BUFFER_HPP
@@ -8,8 +8,14 @@
 #include <rapidjson/ostreamwrapper.h>
 
 #include <boost/format.hpp>
+#include <chrono>
+#include <cmath>
 #include <fstream>
+#include <functional>
+#include <limits>
+#include <numeric>
 #include <sstream>
+#include <unordered_map>
 
 #include "exception.hpp"
 #include "rapidjson/document.h"
@@ -17,22 +23,55 @@
 
 namespace genetic_tetris {
 
+namespace {
+
+/// Candidate placements scored by generateBestMove() on this thread
+thread_local std::uint64_t placements_evaluated = 0;
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+EvolutionaryAlgo::BoardSnapshot makeSnapshot(const Tetris& tetris, bool playing) {
+    EvolutionaryAlgo::BoardSnapshot snapshot{};
+    Tetris::GridView grid = tetris.getGridView();
+    for (int y = 0; y < Tetris::GRID_VISIBLE_HEIGHT; y++) {
+        snapshot.rows[y] = grid.getOccupancy(y);
+    }
+    snapshot.playing = playing;
+    return snapshot;
+}
+
+}  // namespace
+
+EvolutionaryAlgo::EvolutionaryAlgo(Tetris& tetris) : AI(tetris), progress_(Progress{}) {
+    snapshots_.reserve(MOSAIC_BOARDS);
+    for (std::size_t i = 0; i < MOSAIC_BOARDS; i++) {
+        snapshots_.push_back(std::make_unique<SeqLock<BoardSnapshot>>(BoardSnapshot{}));
+    }
+}
+
 Move EvolutionaryAlgo::generateBestMove(const Genome& genome, Tetris& tetris) {
     Move best_move;
     float initial_best = -10000000.0f;
     float best_fitness = initial_best;
+    Tetris::Journal journal;
     for (int mx = Move::MIN_MOVE; mx <= Move::MAX_MOVE; mx++) {
         for (int rot = Move::MIN_ROT; rot <= Move::MAX_ROT; rot++) {
-            Tetris tmp(tetris);
             Move move(mx, rot);
-            move.apply(tmp);
-            if (tmp.isFinished()) continue;
+            if (!move.apply(tetris, journal)) continue;
+            placements_evaluated++;
+            if (tetris.isFinished()) {
+                tetris.undo(journal);
+                continue;
+            }
             float fitness = genome.max_height * (float)move.getMaxHeight() +
                             genome.cumulative_height * (float)move.getCumulativeHeight() +
                             genome.relative_height * (float)move.getRelativeHeight() +
                             genome.holes * (float)move.getHoles() +
                             genome.roughness * (float)move.getRoughness() +
-                            genome.rows_cleared * (float)tmp.getLastTickClearedRowsCount();
+                            genome.rows_cleared * (float)tetris.getLastTickClearedRowsCount();
+            tetris.undo(journal);
             if (fitness > best_fitness) {
                 best_fitness = fitness;
                 best_move = move;
@@ -90,25 +129,78 @@ void EvolutionaryAlgo::tick() {
 
 bool EvolutionaryAlgo::isDroppingSmoothly() const { return is_dropping_smoothly_; }
 
-std::string EvolutionaryAlgo::getInfo() const {
+std::string EvolutionaryAlgo::getInfo() const { return formatInfo(progress_.load()); }
+
+Genome EvolutionaryAlgo::getBest() const {
+    Progress::Best best = progress_.load().best;
+    return Genome(best.id, best.score, best.rows_cleared, best.max_height, best.cumulative_height,
+                  best.relative_height, best.holes, best.roughness);
+}
+
+EvolutionaryAlgo::Stats EvolutionaryAlgo::getStats() const { return progress_.load().stats; }
+
+void EvolutionaryAlgo::setMosaicEnabled(bool enabled) {
+    mosaic_enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+bool EvolutionaryAlgo::isMosaicEnabled() const {
+    return mosaic_enabled_.load(std::memory_order_relaxed);
+}
+
+std::size_t EvolutionaryAlgo::getMosaicBoardCount() const {
+    return std::min(config_.pop_size, MOSAIC_BOARDS);
+}
+
+EvolutionaryAlgo::BoardSnapshot EvolutionaryAlgo::getBoardSnapshot(std::size_t genome) const {
+    return snapshots_[genome]->load();
+}
+
+std::string EvolutionaryAlgo::formatInfo(const Progress& progress) {
+    const Progress::Best& best = progress.best;
+    const TaskScheduler::BatchStats& evaluation = progress.evaluation;
     std::stringstream string_stream;
-    string_stream << "Generation " << t_ << ": " << std::endl;
-    string_stream << "\tmean fitness: " << mean_fitness_ << std::endl;
+    string_stream << "Generation " << progress.generation << ": " << std::endl;
+    string_stream << "\tmean fitness: " << progress.mean_fitness << std::endl;
+    string_stream << boost::format("\tevaluation: %.2fs, utilization=%.0f%%, steals=%d\n") %
+                         evaluation.wall_seconds % (evaluation.utilization * 100.0) %
+                         evaluation.steals;
+    if (progress.cache_total_lookups > 0) {
+        // cache keys include seeds, so without fixed seeds nothing carries over to next generation
+        const char* scope =
+            progress.fixed_seeds ? "" : " (seeds not fixed, within generation only)";
+        string_stream << boost::format("\tfitness cache: %d/%d hits, %.0f%% overall%s\n") %
+                             progress.cache_hits % progress.cache_lookups %
+                             (100.0 * (double)progress.cache_total_hits /
+                              (double)progress.cache_total_lookups) %
+                             scope;
+    }
     string_stream << boost::format(
                          "\tbest: "
                          "{\n\t\tid=%8%\n\t\tscore=%1%\n\t\tmax_h=%2%\n\t\trows_cleared=%3%"
                          "\n\t\tcumulative_h=%4%\n\t\t"
                          "relative_h=%5%\n\t\tholes=%6%\n\t\troughness=%7%)\n\t}") %
-                         best_.score % best_.max_height % best_.rows_cleared %
-                         best_.cumulative_height % best_.relative_height % best_.holes %
-                         best_.roughness % best_.id;
+                         best.score % best.max_height % best.rows_cleared %
+                         best.cumulative_height % best.relative_height % best.holes %
+                         best.roughness % best.id;
     return string_stream.str();
 }
 
-Genome EvolutionaryAlgo::getBest() const { return best_; }
+std::string EvolutionaryAlgo::formatStats(const Stats& stats) {
+    std::stringstream string_stream;
+    string_stream << "Generation " << stats.generation << " stats:" << std::endl;
+    string_stream << "\tpieces: " << stats.pieces << " (" << stats.total_pieces << " total)"
+                  << std::endl;
+    string_stream << "\tplacements: " << stats.placements << " (" << stats.total_placements
+                  << " total)" << std::endl;
+    string_stream << boost::format("\tplacements/s: %.0f\n") % stats.placements_per_second;
+    string_stream << boost::format("\tselection: %.2fms\n\tmutation: %.2fms\n") %
+                         (stats.selection_seconds * 1e3) % (stats.mutation_seconds * 1e3);
+    string_stream << boost::format("\tevaluation: %.2fms\n") % (stats.evaluation_seconds * 1e3);
+    return string_stream.str();
+}
 
 void EvolutionaryAlgo::save() {
-    saveToJSON(GENOMES_FILE, generation_bests_);
+    saveToJSON(config_.genomes_file, generation_bests_);
     EventManager::getInstance().addEvent(EventType::GENOMES_SAVED);
 }
 
@@ -174,7 +266,7 @@ void EvolutionaryAlgo::play() {
     finish_ = drop_ = smooth_drop_ = false;
 
     try {
-        generation_bests_ = loadFromJSON(GENOMES_FILE);
+        generation_bests_ = loadFromJSON(config_.genomes_file);
     } catch (GenomeFileNotFoundException& e) {
         available_generations_ = 0;
     }
@@ -194,7 +286,9 @@ void EvolutionaryAlgo::play() {
         }
         if (drop_) {
             Genome genome = generation_bests_[playing_generation_];
-            Move move = generateBestMove(genome, tetris_);
+            // Search on a copy, GUI thread is drawing tetris_ at the same time
+            Tetris search(tetris_);
+            Move move = generateBestMove(genome, search);
             move.apply(tetris_, !smooth_drop_);
             if (smooth_drop_) {
                 is_dropping_smoothly_ = true;
@@ -211,35 +305,98 @@ void EvolutionaryAlgo::play() {
 
 void EvolutionaryAlgo::evolve() {
     t_ = 0;
+    seeds_.clear();
+    fitness_cache_.clear();
+    cache_total_hits_ = cache_total_lookups_ = 0;
+    generation_pieces_ = generation_placements_ = 0;
+    stats_ = Stats();
+    scheduler_ = std::make_unique<TaskScheduler>(config_.threads);
     auto pop = initialPop();
-    while (!finish_) {
+    while (!finish_ && (config_.max_generations == 0 || t_ < config_.max_generations)) {
         pop = nextGeneration(pop);
     }
+    scheduler_.reset();
+}
+
+TaskScheduler::BatchStats EvolutionaryAlgo::evaluateOnce(std::vector<Genome>& pop) {
+    finish_ = false;
+    fitness_cache_.clear();
+    if (!scheduler_) {
+        scheduler_ = std::make_unique<TaskScheduler>(config_.threads);
+    }
+    evaluation(pop);
+    return evaluation_stats_;
 }
 
 std::vector<Genome> EvolutionaryAlgo::nextGeneration(std::vector<Genome>& pop) {
+    auto start = std::chrono::steady_clock::now();
     auto selected = selection(pop);
+    double selection_seconds = secondsSince(start);
+    start = std::chrono::steady_clock::now();
     auto next_pop = mutation(selected);
+    double mutation_seconds = secondsSince(start);
+    start = std::chrono::steady_clock::now();
     evaluation(next_pop);
+    double evaluation_seconds = secondsSince(start);
     t_++;
-    std::cout << getInfo() << std::endl;
+    Progress progress = publishProgress(selection_seconds, mutation_seconds, evaluation_seconds);
+    std::cout << formatInfo(progress) << std::endl << formatStats(progress.stats) << std::endl;
     return next_pop;
 }
 
+EvolutionaryAlgo::Progress EvolutionaryAlgo::publishProgress(double selection_seconds,
+                                                             double mutation_seconds,
+                                                             double evaluation_seconds) {
+    stats_.generation = t_;
+    stats_.pieces = generation_pieces_.exchange(0);
+    stats_.placements = generation_placements_.exchange(0);
+    stats_.placements_per_second =
+        evaluation_seconds > 0.0 ? (double)stats_.placements / evaluation_seconds : 0.0;
+    stats_.selection_seconds = selection_seconds;
+    stats_.mutation_seconds = mutation_seconds;
+    stats_.evaluation_seconds = evaluation_seconds;
+    stats_.total_pieces += stats_.pieces;
+    stats_.total_placements += stats_.placements;
+
+    Progress progress;
+    progress.generation = t_;
+    progress.mean_fitness = mean_fitness_;
+    progress.best.id = best_.id;
+    progress.best.score = best_.score;
+    progress.best.rows_cleared = best_.rows_cleared;
+    progress.best.max_height = best_.max_height;
+    progress.best.cumulative_height = best_.cumulative_height;
+    progress.best.relative_height = best_.relative_height;
+    progress.best.holes = best_.holes;
+    progress.best.roughness = best_.roughness;
+    progress.evaluation = evaluation_stats_;
+    progress.cache_hits = cache_hits_;
+    progress.cache_lookups = cache_lookups_;
+    progress.cache_total_hits = cache_total_hits_;
+    progress.cache_total_lookups = cache_total_lookups_;
+    progress.fixed_seeds = config_.fixed_seeds;
+    progress.stats = stats_;
+    progress_.store(progress);
+    EventManager::getInstance().addEvent(EventType::GENERATION_FINISHED, t_);
+    return progress;
+}
+
 std::vector<Genome> EvolutionaryAlgo::initialPop() {
-    std::vector<Genome> initial_pop(POP_SIZE);
+    std::vector<Genome> initial_pop(config_.pop_size);
+    auto start = std::chrono::steady_clock::now();
     evaluation(initial_pop);
-    std::cout << getInfo() << std::endl;
+    Progress progress = publishProgress(0.0, 0.0, secondsSince(start));
+    std::cout << formatInfo(progress) << std::endl << formatStats(progress.stats) << std::endl;
     return initial_pop;
 }
 
 std::vector<Genome> EvolutionaryAlgo::selection(std::vector<Genome>& pop) {
+    RandomNumberGenerator& generator = RandomNumberGenerator::getInstance();
     std::vector<Genome> selected;
-    selected.reserve(POP_SIZE);
-    while (selected.size() < POP_SIZE - 1) {
+    selected.reserve(config_.pop_size);
+    while (selected.size() < config_.pop_size - 1) {
         std::vector<Genome> fighters;
-        std::sample(pop.begin(), pop.end(), std::back_inserter(fighters), 2,
-                    std::mt19937{std::random_device{}()});
+        std::sample(pop.begin(), pop.end(), std::back_inserter(fighters), 2, generator);
         if (fighters[0].score > fighters[1].score) {
             selected.push_back(fighters[0]);
         } else {
@@ -258,31 +415,203 @@ std::vector<Genome> EvolutionaryAlgo::mutation(std::vector<Genome>& selected) {
 }
 
 void EvolutionaryAlgo::evaluation(std::vector<Genome>& next_pop) {
-    float score_sum = 0.0f;
-    for (auto& c : next_pop) {
-        Tetris tmp;
-        Move best_move;
-        for (int i = 0; i < MOVES_TO_SIMULATE; i++) {
-            if (finish_) return;
-            best_move = generateBestMove(c, tmp);
-            best_move.apply(tmp);
-            if (tmp.isFinished()) {
-                break;
+    // common random numbers: every genome plays the same games, so scores differ by skill, not luck
+    RandomNumberGenerator& generator = RandomNumberGenerator::getInstance();
+    const auto seeds_count = (std::size_t)std::max(config_.seeds_per_generation, 1);
+    if (!config_.fixed_seeds || seeds_.size() != seeds_count) {
+        seeds_.resize(seeds_count);
+        for (auto& seed : seeds_) {
+            seed = generator.nextSeed();
+        }
+    }
+    const std::vector<std::uint64_t>& seeds = seeds_;
+    // game i is played with seed i % seeds_count by genome i / seeds_count
+    std::vector<Tetris> games;
+    games.reserve(next_pop.size() * seeds_count);
+    for (std::size_t i = 0; i < next_pop.size() * seeds_count; i++) {
+        games.emplace_back(false, seeds[i % seeds_count]);
+    }
+    std::vector<int> moves(games.size(), 0);
+    auto genome_scores = [&](std::size_t g) {
+        std::vector<unsigned int> scores;
+        for (std::size_t i = g * seeds_count; i < (g + 1) * seeds_count; i++) {
+            scores.push_back(games[i].getScore());
+        }
+        return scores;
+    };
+
+    // unchanged genomes are not simulated again, unless racing is enabled, because then
+    // the score depends on the rest of the population
+    const bool use_cache = config_.racing_rounds <= 1;
+    const std::uint64_t seeds_hash = FitnessCache::hashSeeds(seeds);
+    std::vector<std::size_t> alive;
+    // genome with the same weights as an earlier one in this generation, and that earlier one
+    std::vector<std::pair<std::size_t, std::size_t>> duplicates;
+    std::unordered_map<FitnessCache::Key, std::size_t, FitnessCache::KeyHash> first_with_key;
+    cache_hits_ = 0;
+    for (std::size_t g = 0; g < next_pop.size(); g++) {
+        if (!use_cache) {
+            alive.push_back(g);
+            continue;
+        }
+        auto key = FitnessCache::makeKey(next_pop[g], seeds_hash);
+        auto [first, inserted] = first_with_key.emplace(key, g);
+        if (!inserted) {
+            duplicates.emplace_back(g, first->second);
+            cache_hits_++;
+        } else if (fitness_cache_.find(key, next_pop[g].score)) {
+            cache_hits_++;
+        } else {
+            alive.push_back(g);
+        }
+    }
+    cache_lookups_ = use_cache ? next_pop.size() : 0;
+
+    // successive halving: all genomes play a short round, the worst are cut and the rest
+    // play twice as long in the next round, until survivors play full games
+    const int rounds = std::max(config_.racing_rounds, 1);
+    // genomes cut in each round, survivors of the last round are not listed
+    std::vector<std::vector<std::size_t>> cut(rounds);
+    evaluation_stats_ = TaskScheduler::BatchStats();
+    double busy_seconds = 0.0;
+    // read once, so a game is either published in every round or in none
+    const bool mosaic = isMosaicEnabled();
+    if (mosaic) {
+        for (std::size_t g = 0; g < std::min(next_pop.size(), MOSAIC_BOARDS); g++) {
+            snapshots_[g]->store(makeSnapshot(games[g * seeds_count], false));
+        }
+    }
+    for (int round = 0; round < rounds; round++) {
+        const int round_moves = std::max(config_.moves_to_simulate >> (rounds - 1 - round), 1);
+        scheduler_->run(alive.size() * seeds_count, [&](std::size_t task) {
+            std::size_t i = alive[task / seeds_count] * seeds_count + task % seeds_count;
+            std::size_t g = i / seeds_count;
+            // only the first game of a genome is shown
+            SeqLock<BoardSnapshot>* snapshot = nullptr;
+            if (mosaic && i % seeds_count == 0 && g < MOSAIC_BOARDS) {
+                snapshot = snapshots_[g].get();
             }
+            moves[i] += simulate(next_pop[g], games[i], round_moves - moves[i], snapshot);
+        });
+        auto stats = scheduler_->getLastBatchStats();
+        evaluation_stats_.wall_seconds += stats.wall_seconds;
+        evaluation_stats_.steals += stats.steals;
+        busy_seconds += stats.utilization * stats.wall_seconds;
+        if (evaluation_stats_.wall_seconds > 0.0) {
+            evaluation_stats_.utilization = busy_seconds / evaluation_stats_.wall_seconds;
+        }
+        if (finish_) return;
+        if (round == rounds - 1) break;
+
+        // every unfinished game has the same number of moves, so raw scores are comparable
+        std::vector<std::pair<float, std::size_t>> ranking;
+        for (std::size_t g : alive) {
+            auto scores = genome_scores(g);
+            ranking.emplace_back(aggregate(scores, config_.aggregation), g);
         }
-        c.score = (float)tmp.getScore();
+        std::sort(ranking.begin(), ranking.end(), std::greater<>());
+        auto survivors = (std::size_t)std::ceil((float)alive.size() * (1.0f - config_.racing_cut));
+        survivors = std::clamp<std::size_t>(survivors, 1, alive.size());
+        alive.clear();
+        for (std::size_t r = 0; r < ranking.size(); r++) {
+            (r < survivors ? alive : cut[round]).push_back(ranking[r].second);
+        }
+    }
+
+    float floor = std::numeric_limits<float>::max();
+    for (std::size_t g : alive) {
+        auto scores = genome_scores(g);
+        next_pop[g].score = aggregate(scores, config_.aggregation);
+        floor = std::min(floor, next_pop[g].score);
+    }
+    // cut genomes get their score extrapolated to the full game, but never above
+    // any genome that got further than them
+    for (int round = rounds - 2; round >= 0; round--) {
+        float round_floor = floor;
+        for (std::size_t g : cut[round]) {
+            std::vector<unsigned int> scores;
+            for (std::size_t i = g * seeds_count; i < (g + 1) * seeds_count; i++) {
+                float score = (float)games[i].getScore();
+                if (!games[i].isFinished() && moves[i] > 0) {
+                    score *= (float)config_.moves_to_simulate / (float)moves[i];
+                }
+                scores.push_back((unsigned int)score);
+            }
+            next_pop[g].score = std::min(aggregate(scores, config_.aggregation), floor);
+            round_floor = std::min(round_floor, next_pop[g].score);
+        }
+        floor = round_floor;
+    }
+    if (use_cache) {
+        for (std::size_t g : alive) {
+            auto key = FitnessCache::makeKey(next_pop[g], seeds_hash);
+            fitness_cache_.insert(key, next_pop[g].score);
+        }
+        for (auto [g, first] : duplicates) {
+            next_pop[g].score = next_pop[first].score;
+        }
+        cache_total_hits_ += cache_hits_;
+        cache_total_lookups_ += cache_lookups_;
+    }
+
+    float score_sum = 0.0f;
+    for (const auto& c : next_pop) {
         score_sum += c.score;
     }
-    mean_fitness_ = score_sum / POP_SIZE;
+    mean_fitness_ = score_sum / (float)next_pop.size();
     best_ = *std::max_element(next_pop.begin(), next_pop.end(),
                               [](const Genome& a, const Genome& b) { return a.score < b.score; });
     generation_bests_.push_back(best_);
 }
 
+float EvolutionaryAlgo::aggregate(std::vector<unsigned int>& scores, Aggregation aggregation) {
+    if (scores.empty()) return 0.0f;
+    switch (aggregation) {
+        case Aggregation::MEDIAN: {
+            std::sort(scores.begin(), scores.end());
+            std::size_t mid = scores.size() / 2;
+            if (scores.size() % 2 == 1) return (float)scores[mid];
+            return ((float)scores[mid - 1] + (float)scores[mid]) / 2.0f;
+        }
+        case Aggregation::MIN:
+            return (float)*std::min_element(scores.begin(), scores.end());
+        case Aggregation::MEAN:
+        default:
+            double sum = 0.0;
+            for (unsigned int score : scores) {
+                sum += score;
+            }
+            return (float)(sum / (double)scores.size());
+    }
+}
+
+int EvolutionaryAlgo::simulate(const Genome& genome, Tetris& tetris, int moves,
+                               SeqLock<BoardSnapshot>* snapshot) const {
+    int played = 0;
+    std::uint64_t placements_before = placements_evaluated;
+    while (played < moves && !tetris.isFinished() && !finish_) {
+        Move best_move = generateBestMove(genome, tetris);
+        best_move.apply(tetris);
+        played++;
+        if (snapshot != nullptr) {
+            snapshot->store(makeSnapshot(tetris, true));
+        }
+    }
+    if (snapshot != nullptr) {
+        snapshot->store(makeSnapshot(tetris, false));
+    }
+    // merged once per game, so counting doesn't slow down the workers
+    generation_pieces_.fetch_add(played, std::memory_order_relaxed);
+    generation_placements_.fetch_add(placements_evaluated - placements_before,
+                                      std::memory_order_relaxed);
+    return played;
+}
+
 void EvolutionaryAlgo::mutate(Genome& genome) {
-    auto mutate_gene = [this](float gene) {
-        if (generator_.random_0_1() < MUTATION_RATE) {
-            return gene + generator_.random<-1, 1>() * MUTATION_STEP;
+    RandomNumberGenerator& generator = RandomNumberGenerator::getInstance();
+    auto mutate_gene = [this, &generator](float gene) {
+        if (generator.random_0_1() < config_.mutation_rate) {
+            return gene + generator.random<-1, 1>() * config_.mutation_step;
         }
         return gene;
     };
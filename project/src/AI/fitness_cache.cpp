@@ -0,0 +1,65 @@
+/*
+ * Author: Damian Kolaska
+ */
+
+#include "AI/fitness_cache.hpp"
+
+#include <cstring>
+
+namespace genetic_tetris {
+
+namespace {
+
+std::uint64_t mix(std::uint64_t hash, std::uint64_t value) {
+    // splitmix64 finalizer
+    hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6u) + (hash >> 2u);
+    hash = (hash ^ (hash >> 30u)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27u)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31u);
+}
+
+}  // namespace
+
+FitnessCache::Key FitnessCache::makeKey(const Genome& genome, std::uint64_t seeds_hash) {
+    return {{genome.rows_cleared, genome.max_height, genome.cumulative_height,
+             genome.relative_height, genome.holes, genome.roughness},
+            seeds_hash};
+}
+
+std::uint64_t FitnessCache::hashSeeds(const std::vector<std::uint64_t>& seeds) {
+    std::uint64_t hash = seeds.size();
+    for (std::uint64_t seed : seeds) {
+        hash = mix(hash, seed);
+    }
+    return hash;
+}
+
+bool FitnessCache::find(const Key& key, float& fitness) const {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return false;
+    }
+    fitness = it->second;
+    return true;
+}
+
+void FitnessCache::insert(const Key& key, float fitness) {
+    if (entries_.size() >= MAX_ENTRIES) {
+        entries_.clear();
+    }
+    entries_[key] = fitness;
+}
+
+std::size_t FitnessCache::KeyHash::operator()(const Key& key) const {
+    std::uint64_t hash = key.seeds_hash;
+    for (float weight : key.weights) {
+        // -0.0f equals 0.0f, so both must hash the same
+        weight += 0.0f;
+        std::uint32_t bits;
+        std::memcpy(&bits, &weight, sizeof(bits));
+        hash = mix(hash, bits);
+    }
+    return (std::size_t)hash;
+}
+
+}  // namespace genetic_tetris
@@ -6,10 +6,7 @@
 
 namespace genetic_tetris {
 
-Move::Move() {
-    rotations_ = std::rand() % 4;
-    move_x_ = std::rand() % (Tetris::GRID_WIDTH + 1) - 1;
-}
+Move::Move() : move_x_(Tetris::TETROMINO_INITIAL_POS.first), rotations_(0) {}
 
 Move::Move(int moveX, int rotations) : move_x_(moveX), rotations_(rotations) {}
 
@@ -29,8 +26,14 @@ Move &Move::operator=(const Move &other) {
  * @param hard_drop defaults to true, but needs to be false when in PvAI mode for a smooth drop.
  * When false, doesn't invoke calculateGridProperties(),
  * but this function call doesn't have any effect when playing a normal (PvAI) game.
+ * Hard drops use Tetris::place() and fall back to simulating shifts only when the move doesn't
+ * fit in the grid (it is then clamped to the wall, as if a player kept pressing the key).
  */
 void Move::apply(Tetris &tetris, bool hard_drop) {
+    if (hard_drop && tetris.place(getRotation(), getMoveX())) {
+        calculateGridProperties(tetris);
+        return;
+    }
     for (int i = 0; i < getRotation(); ++i) {
         tetris.rotateCW();
     }
@@ -47,8 +50,16 @@ void Move::apply(Tetris &tetris, bool hard_drop) {
     }
     if (hard_drop) {
         tetris.hardDrop(true);
-        calculateGridProperties(tetris.getRawGrid());
+        calculateGridProperties(tetris);
+    }
+}
+
+bool Move::apply(Tetris &tetris, Tetris::Journal &journal) {
+    if (!tetris.applyPlacement(getRotation(), getMoveX(), journal)) {
+        return false;
     }
+    calculateGridProperties(tetris);
+    return true;
 }
 
 int Move::calculateHoles(const Tetris::Grid &grid) {
@@ -95,4 +106,19 @@ void Move::calculateGridProperties(const Tetris::Grid &grid) {
     relative_height_ = max_height_ - min_height;
 }
 
+void Move::calculateGridProperties(const Tetris &tetris) {
+    holes_ = tetris.getHoles();
+    const auto &heights = tetris.getColumnHeights();
+    max_height_ = *std::max_element(heights.begin(), heights.end());
+    int min_height = *std::min_element(heights.begin(), heights.end());
+    relative_height_ = max_height_ - min_height;
+    cumulative_height_ = roughness_ = 0;
+    for (unsigned int x = 0; x < heights.size(); x++) {
+        cumulative_height_ += heights[x];
+        if (x > 0) {
+            roughness_ += std::abs(heights[x] - heights[x - 1]);
+        }
+    }
+}
+
 }  // namespace genetic_tetris
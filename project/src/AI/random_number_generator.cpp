@@ -4,16 +4,49 @@
 
 #include "AI/random_number_generator.hpp"
 
+#include <mutex>
+
+#include "tetris/tetromino_generator.hpp"
+
 namespace genetic_tetris {
 
-RandomNumberGenerator::RandomNumberGenerator()
-    : generator_(std::random_device{}()), dis_0_1(0.0, 1.0) {}
+RandomNumberGenerator::RandomNumberGenerator() {
+    static std::once_flag master_seed_flag;
+    std::call_once(master_seed_flag, []() {
+        if (master_seed_version_ == 0) {
+            master_seed_ = TetrominoGenerator::randomSeed();
+        }
+    });
+    reseed();
+}
 
 RandomNumberGenerator& RandomNumberGenerator::getInstance() {
-    static RandomNumberGenerator instance;
+    thread_local RandomNumberGenerator instance;
+    if (instance.seed_version_ != master_seed_version_) {
+        instance.reseed();
+    }
     return instance;
 }
 
-float RandomNumberGenerator::random_0_1() { return dis_0_1(generator_); }
+void RandomNumberGenerator::setMasterSeed(std::uint64_t seed) {
+    master_seed_ = seed;
+    next_stream_ = 0;
+    ++master_seed_version_;
+    getInstance();
+}
+
+float RandomNumberGenerator::random_0_1() {
+    // 24 random bits fit exactly in float mantissa
+    return (float)(engine_() >> 8u) * (1.0f / (float)(1u << 24u));
+}
+
+std::uint64_t RandomNumberGenerator::nextSeed() {
+    return (static_cast<std::uint64_t>(engine_()) << 32u) | engine_();
+}
+
+void RandomNumberGenerator::reseed() {
+    seed_version_ = master_seed_version_;
+    engine_ = Pcg32(master_seed_, next_stream_++);
+}
 
 }  // namespace genetic_tetris
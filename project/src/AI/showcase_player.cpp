@@ -0,0 +1,66 @@
+/*
+ * Author: Damian Kolaska
+ */
+
+#include "AI/showcase_player.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace genetic_tetris {
+
+ShowcasePlayer::ShowcasePlayer(const EvolutionaryAlgo& ai) : ai_(ai) {
+    publish();
+}
+
+ShowcasePlayer::~ShowcasePlayer() { stop(); }
+
+void ShowcasePlayer::start() {
+    stop();
+    stop_ = false;
+    thread_ = std::thread([this]() { run(); });
+}
+
+void ShowcasePlayer::stop() {
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        stop_ = true;
+    }
+    stop_cond_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    tetris_ = Tetris();
+    publish();
+}
+
+void ShowcasePlayer::run() {
+    using Clock = std::chrono::steady_clock;
+    auto next_move = Clock::now();
+    std::unique_lock<std::mutex> lk(m_);
+    while (!stop_) {
+        lk.unlock();
+        if (tetris_.isFinished()) {
+            tetris_ = Tetris();
+        }
+        auto move = EvolutionaryAlgo::generateBestMove(ai_.getBest(), tetris_);
+        move.apply(tetris_);
+        publish();
+        // a slow move delays the next one instead of making the game catch up
+        double rate = std::max((double)moves_per_second_, MIN_MOVES_PER_SECOND);
+        next_move = std::max(next_move + std::chrono::duration_cast<Clock::duration>(
+                                             std::chrono::duration<double>(1.0 / rate)),
+                             Clock::now());
+        lk.lock();
+        stop_cond_.wait_until(lk, next_move, [this]() { return stop_; });
+    }
+}
+
+void ShowcasePlayer::publish() {
+    Frame& frame = frames_.writeBuffer();
+    tetris_.getDisplayGrid(frame.grid);
+    frame.score = tetris_.getScore();
+    frames_.publish();
+}
+
+}  // namespace genetic_tetris
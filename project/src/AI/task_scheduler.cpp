@@ -0,0 +1,123 @@
+/*
+ * Author: Damian Kolaska
+ */
+
+#include "AI/task_scheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+
+namespace genetic_tetris {
+
+unsigned int TaskScheduler::resolveThreadCount(unsigned int threads) {
+    return threads != 0 ? threads : std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+TaskScheduler::TaskScheduler(unsigned int threads) {
+    threads = resolveThreadCount(threads);
+    idle_workers_ = threads;
+    busy_ns_.resize(threads, 0);
+    queues_.reserve(threads);
+    for (unsigned int i = 0; i < threads; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+    workers_.reserve(threads);
+    for (unsigned int i = 0; i < threads; ++i) {
+        workers_.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        stop_ = true;
+    }
+    work_cond_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void TaskScheduler::run(std::size_t count, const Task& task) {
+    using Clock = std::chrono::steady_clock;
+    std::unique_lock<std::mutex> lk(m_);
+    // workers are idle, so queues can be filled without locking them
+    const std::size_t threads = workers_.size();
+    for (std::size_t w = 0; w < threads; ++w) {
+        auto& tasks = queues_[w]->tasks;
+        for (std::size_t i = count * w / threads; i < count * (w + 1) / threads; ++i) {
+            tasks.push_back(i);
+        }
+    }
+    std::fill(busy_ns_.begin(), busy_ns_.end(), 0);
+    steals_ = 0;
+    task_ = &task;
+    idle_workers_ = 0;
+    ++batch_;
+    auto start = Clock::now();
+    work_cond_.notify_all();
+    done_cond_.wait(lk, [this]() { return idle_workers_ == workers_.size(); });
+    task_ = nullptr;
+
+    stats_.wall_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    double busy_seconds = (double)std::accumulate(busy_ns_.begin(), busy_ns_.end(), 0LL) * 1e-9;
+    stats_.utilization = stats_.wall_seconds > 0.0
+                             ? std::min(busy_seconds / (stats_.wall_seconds * threads), 1.0)
+                             : 0.0;
+    stats_.steals = steals_;
+}
+
+bool TaskScheduler::takeTask(std::size_t id, std::size_t& task) {
+    {
+        WorkQueue& own = *queues_[id];
+        std::lock_guard<std::mutex> lk(own.m);
+        if (!own.tasks.empty()) {
+            task = own.tasks.front();
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+    // tasks are never added during a batch, so one unsuccessful pass means there is no work left
+    for (std::size_t i = 1; i < queues_.size(); ++i) {
+        WorkQueue& victim = *queues_[(id + i) % queues_.size()];
+        std::lock_guard<std::mutex> lk(victim.m);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            ++steals_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::workerLoop(std::size_t id) {
+    using Clock = std::chrono::steady_clock;
+    unsigned long last_batch = 0;
+    std::unique_lock<std::mutex> lk(m_);
+    while (true) {
+        work_cond_.wait(lk, [&]() { return stop_ || batch_ != last_batch; });
+        if (stop_) {
+            return;
+        }
+        last_batch = batch_;
+        const Task& task = *task_;
+        lk.unlock();
+        long long busy_ns = 0;
+        std::size_t i;
+        while (takeTask(id, i)) {
+            auto start = Clock::now();
+            task(i);
+            busy_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start)
+                           .count();
+        }
+        lk.lock();
+        busy_ns_[id] = busy_ns;
+        if (++idle_workers_ == workers_.size()) {
+            done_cond_.notify_one();
+        }
+    }
+}
+
+}  // namespace genetic_tetris
@@ -4,6 +4,7 @@
 
 #include "app.hpp"
 
+#include <iostream>
 #include <thread>
 
 #include "event_manager.hpp"
@@ -17,12 +18,15 @@ App::App()
       tetris_human_(),
       tetris_ai_(),
       ai_(std::ref(tetris_ai_)),
-      gui_(WINDOW_WIDTH_, WINDOW_HEIGHT_, FPS_, tetris_human_, tetris_ai_, ai_),
+      showcase_(ai_),
+      gui_(WINDOW_WIDTH_, WINDOW_HEIGHT_, FPS_, tetris_human_, tetris_ai_, ai_, showcase_),
       game_controller_(tetris_human_, ai_, gui_),
-      evolve_controller_(tetris_ai_, ai_, gui_),
+      evolve_controller_(showcase_, ai_, gui_),
       menu_controller_(gui_),
       state_(State::MENU),
-      active_controller_(&menu_controller_) {}
+      active_controller_(&menu_controller_) {
+    event_manager_.setConsumerAttached(true);
+}
 
 void App::run() {
     sound_manager_.play(SoundManager::Sound::TETRIS_THEME);
@@ -55,8 +59,10 @@ void App::pollSfmlEvents() {
 }
 
 void App::pollCustomEvents() {
-    if (!event_manager_.isEmpty()) {
-        EventType e = event_manager_.pollEvent();
+    Event event{};
+    // drains the queue, including events posted by other threads while it's being drained
+    while (event_manager_.pollEvent(event)) {
+        EventType e = event.type;
         if (e == EventType::PLAY_BUTTON_CLICKED) {
             if (state_ == State::MENU) {
                 gui_.setActiveScreen(GUI::ScreenType::GAME);
@@ -82,10 +88,16 @@ void App::pollCustomEvents() {
         } else if (e == EventType::EXIT_BUTTON_CLICKED) {
             close();
         } else {
-            active_controller_->handleCustomEvent(e);
-            gui_.handleCustomEvent(e);
+            active_controller_->handleCustomEvent(event);
+            gui_.handleCustomEvent(event);
         }
     }
+    std::size_t dropped = event_manager_.getDroppedCount();
+    if (dropped != reported_dropped_events_) {
+        std::cerr << "Event queue full, dropped " << dropped - reported_dropped_events_
+                  << " event(s)" << std::endl;
+        reported_dropped_events_ = dropped;
+    }
 }
 
 void App::close() {
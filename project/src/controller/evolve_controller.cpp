@@ -5,48 +5,42 @@
 #include "controller/evolve_controller.hpp"
 
 #include <AI/evolutionary_algo.hpp>
-#include <tetris/tetris.hpp>
+#include <AI/showcase_player.hpp>
 
 namespace genetic_tetris {
 
-EvolveController::EvolveController(Tetris& tetris_ai, EvolutionaryAlgo& ai, GUI& gui)
-    : Controller(gui), tetris_ai_(tetris_ai), ai_(ai) {}
+EvolveController::EvolveController(ShowcasePlayer& showcase, EvolutionaryAlgo& ai, GUI& gui)
+    : Controller(gui), showcase_(showcase), ai_(ai) {}
 
-void EvolveController::update() {
-    if (state_ == State::STOP) {
-        return;
-    }
-    if (tetris_ai_.isFinished()) {
-        tetris_ai_ = Tetris();
-    }
-    auto move = EvolutionaryAlgo::generateBestMove(ai_.getBest(), tetris_ai_);
-    move.apply(tetris_ai_);
-}
+void EvolveController::update() {}
 
 void EvolveController::start() {
     ai_thread_ = std::thread([this]() { ai_(EvolutionaryAlgo::Mode::EVOLVE); });
+    showcase_.start();
     state_ = State::START;
 }
 
 void EvolveController::reset() {
     finish();
-    tetris_ai_ = Tetris();
     state_ = State::STOP;
 }
 
 void EvolveController::finish() {
+    showcase_.stop();
     ai_.finish();
     if (ai_thread_.joinable()) {
         ai_thread_.join();
     }
 }
 
-void EvolveController::handleCustomEvent(EventType e) {
-    if (e == EventType::START_EVOLVE_BUTTON_CLICKED) {
+void EvolveController::handleCustomEvent(const Event& event) {
+    if (event.type == EventType::START_EVOLVE_BUTTON_CLICKED) {
         reset();
         start();
-    } else if (e == EventType::SAVE_BUTTON_CLICKED) {
+    } else if (event.type == EventType::SAVE_BUTTON_CLICKED) {
         ai_.save();
+    } else if (event.type == EventType::MOSAIC_BUTTON_CLICKED) {
+        ai_.setMosaicEnabled(!ai_.isMosaicEnabled());
     }
 }
 
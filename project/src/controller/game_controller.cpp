@@ -89,8 +89,8 @@ void GameController::handleSfmlEvent(const sf::Event &event) {
     }
 }
 
-void GameController::handleCustomEvent(EventType e) {
-    if (e == EventType::START_GAME_BUTTON_CLICKED) {
+void GameController::handleCustomEvent(const Event &event) {
+    if (event.type == EventType::START_GAME_BUTTON_CLICKED) {
         ai_.setPlayingGeneration(
             dynamic_cast<GameScreen *>(gui_.getActiveScreen())->getPlayingGeneration());
         EventManager::getInstance().addEvent(EventType::GAME_STARTED);
@@ -155,7 +155,6 @@ void GameController::update(EventType e) {
         dynamic_cast<GameScreen*>(gui_.getActiveScreen())->setAvailableGenerations(ai_.getAvailableGenerations());
         state_ = State::STOP;
         reset();
-        EventManager::getInstance().removeEvent(EventType::GAME_STARTED);
         gui_.reset();
     }
 
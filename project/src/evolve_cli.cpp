@@ -0,0 +1,181 @@
+/*
+ * Author: Damian Kolaska
+ */
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "AI/evolutionary_algo.hpp"
+
+using namespace genetic_tetris;
+
+namespace {
+
+volatile std::sig_atomic_t interrupted = 0;
+
+void onInterrupt(int) { interrupted = 1; }
+
+void printUsage(const char* program) {
+    std::cout
+        << "Usage: " << program << " [options]\n"
+        << "Evolves Tetris playing genomes without GUI. Ctrl+C stops and saves the genomes.\n\n"
+        << "  --population N       population size (default 50)\n"
+        << "  --mutation-rate F    probability of mutating a gene (default 0.1)\n"
+        << "  --mutation-step F    strength of a mutation (default 0.2)\n"
+        << "  --moves N            moves simulated in one game (default 400)\n"
+        << "  --threads N          evaluation threads, 0 means all hardware threads (default 0)\n"
+        << "  --generations N      number of generations, 0 means until Ctrl+C (default 0)\n"
+        << "  --output PATH        file the best genomes are saved to (default res/genomes.json)\n"
+        << "  --seeds N            games played by every genome in a generation (default 4)\n"
+        << "  --aggregation NAME   mean, median or min of genome's game scores (default mean)\n"
+        << "  --fixed-seeds        play the same seeds in every generation, so unchanged\n"
+        << "                       genomes reuse cached fitness in later generations\n"
+        << "  --racing N           successive halving rounds, 1 disables racing (default 1)\n"
+        << "  --racing-cut F       fraction of genomes cut after every racing round (default 0.5)\n"
+        << "  --master-seed N      seed of all random number generators\n"
+        << "  --help               show this message\n";
+}
+
+/// Parses non-negative integer, std::stoul would silently wrap negative values
+unsigned long parseCount(const std::string& value) {
+    long long count = std::stoll(value);
+    if (count < 0) {
+        throw std::invalid_argument("negative count");
+    }
+    return (unsigned long)count;
+}
+
+/// Returns true if the directory the genomes will be saved to exists, doesn't create the file
+bool isOutputDirectoryValid(const std::string& file) {
+    std::filesystem::path directory = std::filesystem::path(file).parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+    std::error_code error;
+    return std::filesystem::is_directory(directory, error) &&
+           !std::filesystem::is_directory(file, error);
+}
+
+/// Parses command line into config, returns false if the arguments are invalid
+bool parseArguments(int argc, char** argv, EvolutionaryAlgo::Config& config,
+                    bool& master_seed_set, std::uint64_t& master_seed) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--fixed-seeds") {
+            config.fixed_seeds = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Unknown option or missing value: " << arg << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        try {
+            if (arg == "--population") {
+                config.pop_size = parseCount(value);
+            } else if (arg == "--mutation-rate") {
+                config.mutation_rate = std::stof(value);
+            } else if (arg == "--mutation-step") {
+                config.mutation_step = std::stof(value);
+            } else if (arg == "--moves") {
+                config.moves_to_simulate = std::stoi(value);
+            } else if (arg == "--threads") {
+                config.threads = (unsigned int)parseCount(value);
+            } else if (arg == "--generations") {
+                config.max_generations = std::stoi(value);
+            } else if (arg == "--output") {
+                config.genomes_file = value;
+            } else if (arg == "--seeds") {
+                config.seeds_per_generation = std::stoi(value);
+            } else if (arg == "--aggregation") {
+                if (value == "mean") {
+                    config.aggregation = EvolutionaryAlgo::Aggregation::MEAN;
+                } else if (value == "median") {
+                    config.aggregation = EvolutionaryAlgo::Aggregation::MEDIAN;
+                } else if (value == "min") {
+                    config.aggregation = EvolutionaryAlgo::Aggregation::MIN;
+                } else {
+                    std::cerr << "Unknown aggregation: " << value << std::endl;
+                    return false;
+                }
+            } else if (arg == "--racing") {
+                config.racing_rounds = std::stoi(value);
+            } else if (arg == "--racing-cut") {
+                config.racing_cut = std::stof(value);
+            } else if (arg == "--master-seed") {
+                master_seed = std::stoull(value);
+                master_seed_set = true;
+            } else {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                return false;
+            }
+        } catch (std::exception&) {
+            std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+            return false;
+        }
+    }
+    if (config.pop_size < 2 || config.moves_to_simulate < 1 || config.seeds_per_generation < 1 ||
+        config.racing_rounds < 1 || config.max_generations < 0 || !(config.racing_cut >= 0.0f) ||
+        config.racing_cut >= 1.0f) {
+        std::cerr << "Population must be at least 2, moves, seeds and racing rounds at least 1, "
+                  << "racing cut in [0, 1)" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        }
+    }
+    EvolutionaryAlgo::Config config;
+    bool master_seed_set = false;
+    std::uint64_t master_seed = 0;
+    if (!parseArguments(argc, argv, config, master_seed_set, master_seed)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (!isOutputDirectoryValid(config.genomes_file)) {
+        std::cerr << "Cannot save genomes to " << config.genomes_file << std::endl;
+        return 1;
+    }
+    if (master_seed_set) {
+        RandomNumberGenerator::setMasterSeed(master_seed);
+    }
+
+    Tetris tetris;
+    EvolutionaryAlgo ai(tetris);
+    ai.setConfig(config);
+
+    std::signal(SIGINT, onInterrupt);
+    std::signal(SIGTERM, onInterrupt);
+    std::atomic<bool> done{false};
+    // generations are printed by the algorithm itself, main thread only watches for Ctrl+C
+    std::thread ai_thread([&ai, &done]() {
+        ai(EvolutionaryAlgo::Mode::EVOLVE);
+        done = true;
+    });
+    while (!done) {
+        if (interrupted) {
+            ai.finish();
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    ai_thread.join();
+    ai.save();
+    return 0;
+}
@@ -7,11 +7,11 @@
 namespace genetic_tetris {
 
 GUI::GUI(int width, int height, int fps, Tetris& human_tetris, Tetris& ai_tetris,
-         EvolutionaryAlgo& ai)
+         EvolutionaryAlgo& ai, ShowcasePlayer& showcase)
     : window_(sf::VideoMode(width, height), "Tetris AI"),
       menu_screen_(window_),
       game_screen_(window_, human_tetris, ai_tetris),
-      evolve_screen_(window_, ai, ai_tetris),
+      evolve_screen_(window_, ai, showcase),
       active_screen_(&menu_screen_) {
     window_.setFramerateLimit(fps);
 }
@@ -26,7 +26,7 @@ bool GUI::pollEvent(sf::Event& event) { return window_.pollEvent(event); }
 
 void GUI::handleSfmlEvent(const sf::Event& event) { active_screen_->handleSfmlEvent(event); }
 
-void GUI::handleCustomEvent(EventType event) { active_screen_->handleCustomEvent(event); }
+void GUI::handleCustomEvent(const Event& event) { active_screen_->handleCustomEvent(event); }
 
 void GUI::reset() { active_screen_->reset(); }
 
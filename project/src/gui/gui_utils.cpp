@@ -4,101 +4,209 @@
 
 #include "gui/gui_utils.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include "sound_manager.hpp"
 
 namespace genetic_tetris {
 
-const std::map<Tetromino::Color, sf::Color> &getTetrominoColorMap() {
-    static const std::map<Tetromino::Color, sf::Color> TETROMINO_COLOR_MAP = {
-        {Tetromino::Color::EMPTY, sf::Color(255, 250, 250)},
-        {Tetromino::Color::CYAN, sf::Color(0x00bcd4ff)},
-        {Tetromino::Color::YELLOW, sf::Color(0xffeb3bff)},
-        {Tetromino::Color::PURPLE, sf::Color(0x9c27b0ff)},
-        {Tetromino::Color::GREEN, sf::Color(0x4caf50ff)},
-        {Tetromino::Color::RED, sf::Color(0xf44336ff)},
-        {Tetromino::Color::BLUE, sf::Color(0x2196f3ff)},
-        {Tetromino::Color::ORANGE, sf::Color(0xff9800ff)},
-        {Tetromino::Color::GHOST, sf::Color(0xcfd8dcff)}};
-    return TETROMINO_COLOR_MAP;
+const std::array<sf::Color, Tetromino::COLORS_COUNT> &getTetrominoColors() {
+    // same order as Tetromino::Color
+    static const std::array<sf::Color, Tetromino::COLORS_COUNT> TETROMINO_COLORS = {
+        sf::Color(255, 250, 250),  // EMPTY
+        sf::Color(0x00bcd4ff),     // CYAN
+        sf::Color(0xffeb3bff),     // YELLOW
+        sf::Color(0x9c27b0ff),     // PURPLE
+        sf::Color(0x4caf50ff),     // GREEN
+        sf::Color(0xf44336ff),     // RED
+        sf::Color(0x2196f3ff),     // BLUE
+        sf::Color(0xff9800ff),     // ORANGE
+        sf::Color(0xcfd8dcff)};    // GHOST
+    return TETROMINO_COLORS;
 }
 
 TetrisBoard::TetrisBoard(const sf::Vector2f &position, const sf::Vector2i &board_tile_count,
                          const TileProperties &tile_prop)
-    : state_finished_(false), board_(board_tile_count.y), board_tile_count_(board_tile_count) {
+    : state_finished_(false),
+      tile_colors_(board_tile_count.x * board_tile_count.y, Tetromino::Color::EMPTY),
+      next_tile_colors_(tile_colors_),
+      revision_(NO_REVISION_),
+      tiles_(sf::Quads, (std::size_t)(board_tile_count.x * board_tile_count.y * TILE_VERTICES_)),
+      board_tile_count_(board_tile_count) {
     for (int y = 0; y < board_tile_count.y; ++y) {
         for (int x = 0; x < board_tile_count.x; ++x) {
-            board_[y].push_back(sf::RectangleShape(sf::Vector2f(tile_prop.size, tile_prop.size)));
-            board_[y][x].setFillColor(getTetrominoColorMap().at(Tetromino::Color::EMPTY));
             sf::Vector2f tile_pos(
                 tile_prop.padding + position.x + (float)x * tile_prop.padded_size,
                 tile_prop.padding + position.y + (float)y * tile_prop.padded_size);
-            board_[y][x].setPosition(tile_pos);
+            sf::Vertex *quad = &tiles_[(y * board_tile_count.x + x) * TILE_VERTICES_];
+            quad[0].position = tile_pos;
+            quad[1].position = tile_pos + sf::Vector2f(tile_prop.size, 0);
+            quad[2].position = tile_pos + sf::Vector2f(tile_prop.size, tile_prop.size);
+            quad[3].position = tile_pos + sf::Vector2f(0, tile_prop.size);
+            setTileColor(x, y, Tetromino::Color::EMPTY);
         }
     }
 }
 
 void TetrisBoard::setState(const Tetris::Grid &tetris_grid) {
     for (int y = 0; y < board_tile_count_.y; ++y) {
-        int x = 0;
-        for (auto tile_color : tetris_grid[y]) {
-            int mapped_y = board_tile_count_.y - y - 1;
-            auto base_color = getTetrominoColorMap().at(tile_color);
-            sf::Color result_color = base_color;
-            if (state_finished_) {
-                result_color = base_color - FINISHED_HUE_CHANGE_;
-            }
-            board_[mapped_y][x].setFillColor(result_color);
-            ++x;
-        }
+        int mapped_y = board_tile_count_.y - y - 1;
+        std::copy(tetris_grid[y].begin(), tetris_grid[y].begin() + board_tile_count_.x,
+                  next_tile_colors_.begin() + mapped_y * board_tile_count_.x);
+    }
+    applyNextTileColors();
+}
+
+void TetrisBoard::setState(const Tetris &tetris) {
+    if (tetris.getRevision() == revision_) {
+        return;
     }
+    revision_ = tetris.getRevision();
+    tetris.getDisplayGrid(grid_);
+    setState(grid_);
 }
 
-void TetrisBoard::setTetrominoQueue(const std::deque<Tetromino> &queue) {
+void TetrisBoard::setTetrominoQueue(const TetrominoGenerator::QueueView &queue) {
     const int TETROMINO_GAP = 4;
     const int TETROMINO_SIZE = 4;
     int y = 0;
     int start_x = (board_tile_count_.x - TETROMINO_SIZE) / 2;
     int start_y = (TETROMINO_GAP - TETROMINO_SIZE) / 2;
     // clear board
-    sf::Color empty = getTetrominoColorMap().at(Tetromino::Color::EMPTY);
-    for (auto &row : board_) {
-        for (auto &rect : row) {
-            rect.setFillColor(empty);
-        }
-    }
+    std::fill(next_tile_colors_.begin(), next_tile_colors_.end(), Tetromino::Color::EMPTY);
     // draw tetrominoes
     for (const Tetromino &tetromino : queue) {
         if (y + TETROMINO_GAP >= board_tile_count_.y) {
             break;
         }
         Tetromino::Color color = tetromino.getColor();
-        sf::Color mapped_color = getTetrominoColorMap().at(color);
         for (const Tetromino::Square &square : tetromino.getSquares()) {
             int t_x = start_x + square.first;
             int t_y = y + start_y + square.second;
             if (t_x >= 0 && t_y >= 0 && t_x < board_tile_count_.x && t_y < board_tile_count_.y) {
-                board_[t_y][t_x].setFillColor(mapped_color);
+                next_tile_colors_[t_y * board_tile_count_.x + t_x] = color;
             }
         }
         y += TETROMINO_GAP;
     }
+    applyNextTileColors();
 }
 
-void TetrisBoard::draw(sf::RenderWindow &window) {
-    for (const auto &row : board_) {
-        for (const auto &tile : row) {
-            window.draw(tile);
+void TetrisBoard::draw(sf::RenderWindow &window) { window.draw(tiles_); }
+
+void TetrisBoard::reset() {
+    setStateFinished(false);
+    revision_ = NO_REVISION_;
+}
+
+bool TetrisBoard::isStateFinished() const { return state_finished_; }
+
+void TetrisBoard::setStateFinished(bool finished) {
+    if (finished == state_finished_) {
+        return;
+    }
+    state_finished_ = finished;
+    // tint changes every tile
+    for (int y = 0; y < board_tile_count_.y; ++y) {
+        for (int x = 0; x < board_tile_count_.x; ++x) {
+            setTileColor(x, y, tile_colors_[y * board_tile_count_.x + x]);
         }
     }
 }
 
-void TetrisBoard::reset() { setStateFinished(false); }
+void TetrisBoard::setTileColor(int x, int y, Tetromino::Color color) {
+    int tile = y * board_tile_count_.x + x;
+    tile_colors_[tile] = color;
+    sf::Color result_color = getTetrominoColors()[(int)color];
+    if (state_finished_) {
+        result_color = result_color - FINISHED_HUE_CHANGE_;
+    }
+    sf::Vertex *quad = &tiles_[tile * TILE_VERTICES_];
+    for (int i = 0; i < TILE_VERTICES_; ++i) {
+        quad[i].color = result_color;
+    }
+}
 
-bool TetrisBoard::isStateFinished() const { return state_finished_; }
+void TetrisBoard::applyNextTileColors() {
+    for (int y = 0; y < board_tile_count_.y; ++y) {
+        for (int x = 0; x < board_tile_count_.x; ++x) {
+            Tetromino::Color color = next_tile_colors_[y * board_tile_count_.x + x];
+            if (color != tile_colors_[y * board_tile_count_.x + x]) {
+                setTileColor(x, y, color);
+            }
+        }
+    }
+}
 
-void TetrisBoard::setStateFinished(bool finished) { state_finished_ = finished; }
+MosaicBoard::MosaicBoard(const sf::Vector2f &position, std::size_t board_count,
+                         std::size_t columns, float tile_size, float gap)
+    : board_count_(board_count),
+      rows_(board_count, Rows{}),
+      playing_(board_count, false),
+      tiles_(sf::Quads,
+             board_count * Tetris::GRID_WIDTH * Tetris::GRID_VISIBLE_HEIGHT * TILE_VERTICES_) {
+    const sf::Vector2f board_size(tile_size * Tetris::GRID_WIDTH + gap,
+                                  tile_size * Tetris::GRID_VISIBLE_HEIGHT + gap);
+    for (std::size_t board = 0; board < board_count_; ++board) {
+        sf::Vector2f board_pos(position.x + (float)(board % columns) * board_size.x,
+                               position.y + (float)(board / columns) * board_size.y);
+        for (int y = 0; y < Tetris::GRID_VISIBLE_HEIGHT; ++y) {
+            for (int x = 0; x < Tetris::GRID_WIDTH; ++x) {
+                sf::Vector2f tile_pos(
+                    board_pos.x + (float)x * tile_size,
+                    board_pos.y + (float)(Tetris::GRID_VISIBLE_HEIGHT - y - 1) * tile_size);
+                std::size_t tile =
+                    (board * Tetris::GRID_VISIBLE_HEIGHT + y) * Tetris::GRID_WIDTH + x;
+                sf::Vertex *quad = &tiles_[tile * TILE_VERTICES_];
+                quad[0].position = tile_pos;
+                quad[1].position = tile_pos + sf::Vector2f(tile_size, 0);
+                quad[2].position = tile_pos + sf::Vector2f(tile_size, tile_size);
+                quad[3].position = tile_pos + sf::Vector2f(0, tile_size);
+                setTileColor(board, x, y, false, false);
+            }
+        }
+    }
+}
+
+void MosaicBoard::setBoard(std::size_t board, const Rows &rows, bool playing) {
+    if (board >= board_count_) {
+        return;
+    }
+    // the tint changes every square, otherwise only squares that differ are recolored
+    bool tint_changed = playing != playing_[board];
+    playing_[board] = playing;
+    for (int y = 0; y < Tetris::GRID_VISIBLE_HEIGHT; ++y) {
+        unsigned int changed = tint_changed ? Tetris::FULL_ROW : rows[y] ^ rows_[board][y];
+        for (int x = 0; changed != 0; ++x, changed >>= 1u) {
+            if ((changed & 1u) != 0) {
+                setTileColor(board, x, y, (rows[y] & (1u << x)) != 0, playing);
+            }
+        }
+    }
+    rows_[board] = rows;
+}
+
+void MosaicBoard::draw(sf::RenderWindow &window) { window.draw(tiles_); }
+
+void MosaicBoard::reset() {
+    for (std::size_t board = 0; board < board_count_; ++board) {
+        setBoard(board, Rows{}, false);
+    }
+}
+
+void MosaicBoard::setTileColor(std::size_t board, int x, int y, bool filled, bool playing) {
+    sf::Color color =
+        filled ? FILLED_COLOR_ : getTetrominoColors()[(int)Tetromino::Color::EMPTY];
+    if (!playing) {
+        color = color - STOPPED_HUE_CHANGE_;
+    }
+    std::size_t tile = (board * Tetris::GRID_VISIBLE_HEIGHT + y) * Tetris::GRID_WIDTH + x;
+    sf::Vertex *quad = &tiles_[tile * TILE_VERTICES_];
+    for (int i = 0; i < TILE_VERTICES_; ++i) {
+        quad[i].color = color;
+    }
+}
 
 Button::Button() : sound_manager_(SoundManager::getInstance()) {}
 
@@ -209,6 +317,7 @@ void IncDecDialog::build() {
     plus_button_.setText("+", font_, font_size_);
     minus_button_.setText("-", font_, font_size_);
     value_ = std::clamp(value_, value_bounds_.x, value_bounds_.y);
+    value_text_.setString(std::to_string(value_));
     plus_button_.setOnClick([this]() {
         ++value_;
         value_ = std::clamp(value_, value_bounds_.x, value_bounds_.y);
@@ -9,26 +9,46 @@
 namespace genetic_tetris {
 
 EvolveScreen::EvolveScreen(sf::RenderWindow& window, EvolutionaryAlgo& ai,
-                           const Tetris& tetris_ai)
+                           ShowcasePlayer& showcase)
     : Screen(window),
       ai_(ai),
-      tetris_ai_(tetris_ai),
+      showcase_(showcase),
       board_ai_(sf::Vector2f(270, 20),
                 sf::Vector2i(Tetris::GRID_WIDTH, Tetris::GRID_VISIBLE_HEIGHT),
-                TetrisBoard::TileProperties(25.0f, 0.5f)) {
+                TetrisBoard::TileProperties(25.0f, 0.5f)),
+      // 10 x 10 boards, 28 x 53 px each, ends left of stats_ at x = 540
+      mosaic_(sf::Vector2f(250, 20), EvolutionaryAlgo::MOSAIC_BOARDS, 10, 2.5f, 3.0f) {
     createBackButton();
     createStartStopButton();
     createSaveButton();
+    createMosaicButton();
+    createShowcaseControls();
     createInfo();
+    createStats();
     createStatus();
 }
 
 void EvolveScreen::update() {
-    board_ai_.setState(tetris_ai_.getDisplayGrid());
+    if (ai_.isMosaicEnabled()) {
+        // evaluation games are played on worker threads, draw the last published state of each
+        for (std::size_t genome = 0; genome < ai_.getMosaicBoardCount(); genome++) {
+            EvolutionaryAlgo::BoardSnapshot snapshot = ai_.getBoardSnapshot(genome);
+            mosaic_.setBoard(genome, snapshot.rows, snapshot.playing);
+        }
+    } else if (showcase_.consume()) {
+        // showcase game is played on another thread, draw its newest board if there is one
+        board_ai_.setState(showcase_.getFrame().grid);
+        showcase_score_.setString("Score: " + std::to_string(showcase_.getFrame().score));
+    }
+    showcase_speed_dialog_.update();
+    auto speed = (double)showcase_speed_dialog_.getValue();
+    if (speed != showcase_.getMovesPerSecond()) {
+        showcase_.setMovesPerSecond(speed);
+    }
     back_button_.update();
     start_stop_button_.update();
     save_button_.update();
-    info_.setString(ai_.getInfo());
+    mosaic_button_.update();
     if (status_clock_.getElapsedTime() > STATUS_PERSISTENCE_) {
         status_.setString("");
     }
@@ -36,34 +56,66 @@ void EvolveScreen::update() {
 
 void EvolveScreen::draw() {
     window_.clear(BG_COLOR);
-    board_ai_.draw(window_);
+    if (ai_.isMosaicEnabled()) {
+        mosaic_.draw(window_);
+    } else {
+        board_ai_.draw(window_);
+        window_.draw(showcase_score_);
+        window_.draw(showcase_speed_text_);
+        window_.draw(showcase_speed_dialog_);
+    }
     window_.draw(info_);
+    window_.draw(stats_);
     window_.draw(status_);
     window_.draw(back_button_);
     window_.draw(start_stop_button_);
     window_.draw(save_button_);
+    window_.draw(mosaic_button_);
     window_.display();
 }
 
-void EvolveScreen::reset() { board_ai_.reset(); }
+void EvolveScreen::reset() {
+    board_ai_.reset();
+    mosaic_.reset();
+    updateInfo();
+}
 
 void EvolveScreen::handleSfmlEvent(const sf::Event& event) {
     back_button_.handleEvent(event, window_);
     start_stop_button_.handleEvent(event, window_);
     save_button_.handleEvent(event, window_);
+    mosaic_button_.handleEvent(event, window_);
+    if (!ai_.isMosaicEnabled()) {
+        showcase_speed_dialog_.handleEvent(event, window_);
+    }
 }
 
-void EvolveScreen::handleCustomEvent(EventType event) {
-    if (event == EventType::GENOMES_SAVED) {
+void EvolveScreen::handleCustomEvent(const Event& event) {
+    if (event.type == EventType::GENOMES_SAVED) {
         status_.setString("Genomes saved");
         status_clock_.restart();
+    } else if (event.type == EventType::GENERATION_FINISHED) {
+        updateInfo();
+    } else if (event.type == EventType::MOSAIC_BUTTON_CLICKED) {
+        // controller has already switched the mode
+        mosaic_button_.setText(ai_.isMosaicEnabled() ? "SINGLE" : "MOSAIC", font_);
     }
 }
 
+void EvolveScreen::updateInfo() {
+    EvolutionaryAlgo::Progress progress = ai_.getProgress();
+    info_.setString(EvolutionaryAlgo::formatInfo(progress));
+    stats_.setString(EvolutionaryAlgo::formatStats(progress.stats));
+}
+
 void EvolveScreen::createInfo() {
     info_ = createText(sf::Vector2f(90, 570), (int)(FONT_SIZE * 0.65));
 }
 
+void EvolveScreen::createStats() {
+    stats_ = createText(sf::Vector2f(540, 20), (int)(FONT_SIZE * 0.55));
+}
+
 void EvolveScreen::createBackButton() {
     back_button_.setPosition(sf::Vector2f(90, 800));
     back_button_.setSize(sf::Vector2f(200, 50));
@@ -88,6 +140,25 @@ void EvolveScreen::createSaveButton() {
         []() { EventManager::getInstance().addEvent(EventType::SAVE_BUTTON_CLICKED); });
 }
 
+void EvolveScreen::createMosaicButton() {
+    mosaic_button_.setPosition(sf::Vector2f(560, 500));
+    mosaic_button_.setSize(sf::Vector2f(200, 50));
+    mosaic_button_.setText("MOSAIC", font_);
+    mosaic_button_.setOnClick(
+        []() { EventManager::getInstance().addEvent(EventType::MOSAIC_BUTTON_CLICKED); });
+}
+
+void EvolveScreen::createShowcaseControls() {
+    showcase_score_ = createText(sf::Vector2f(20, 20), (int)(FONT_SIZE * 0.75));
+    showcase_speed_text_ = createText(sf::Vector2f(20, 100), (int)(FONT_SIZE * 0.75));
+    showcase_speed_text_.setString("moves/s");
+    showcase_speed_dialog_.setFont(font_, (int)(FONT_SIZE * 0.75))
+        .setPosition(sf::Vector2f(140, 100))
+        .setValueBounds(SHOWCASE_SPEED_BOUNDS_);
+    showcase_speed_dialog_.setValue((int)showcase_.getMovesPerSecond());
+    showcase_speed_dialog_.build();
+}
+
 void EvolveScreen::createStatus() {
     status_ = createText(sf::Vector2f(10, 870), (int)(FONT_SIZE * 0.65));
 }
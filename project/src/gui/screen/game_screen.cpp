@@ -40,8 +40,9 @@ void GameScreen::update() {
     if (tetris_human_.isFinished() && !board_human_.isStateFinished())
         board_human_.setStateFinished(true);
     if (tetris_ai_.isFinished() && !board_ai_.isStateFinished()) board_ai_.setStateFinished(true);
-    board_human_.setState(tetris_human_.getDisplayGrid());
-    board_ai_.setState(tetris_ai_.getDisplayGrid());
+    // boards are updated only if games changed since the last frame
+    board_human_.setState(tetris_human_);
+    board_ai_.setState(tetris_ai_);
     next_tetromino_panel_.setTetrominoQueue(tetris_human_.getTetrominoQueue());
     human_score_.setString("Human: " + std::to_string(tetris_human_.getScore()));
     human_level_.setString("Level: " + std::to_string(tetris_human_.getLevel()) + "/" +
@@ -94,12 +95,14 @@ void GameScreen::handleSfmlEvent(const sf::Event& event) {
     generation_number_dialog_.handleEvent(event, window_);
 }
 
-void GameScreen::handleCustomEvent(EventType event) {
-    if (event == EventType::GENERATION_OUT_OF_BOUNDS) {
+void GameScreen::handleCustomEvent(const Event& event) {
+    if (event.type == EventType::GENERATION_OUT_OF_BOUNDS) {
+        // GAME_STARTED was handled before, game didn't start after all
+        state_ = State::STOP;
         status_.setString(
             "Currently available generations: " + std::to_string(available_generations_));
         status_clock_.restart();
-    } else if (event == EventType::GAME_STARTED) {
+    } else if (event.type == EventType::GAME_STARTED) {
         state_ = State::START;
     }
 }
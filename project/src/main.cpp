@@ -1,10 +1,6 @@
-#include <cstdlib>
-#include <ctime>
-
 #include "app.hpp"
 
 int main() {
-    srand(time(nullptr));
     genetic_tetris::App app;
     app.run();
 }
\ No newline at end of file
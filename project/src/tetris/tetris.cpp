@@ -4,12 +4,10 @@
 
 #include "tetris/tetris.hpp"
 
-#ifdef _WIN32
-#define _USE_MATH_DEFINES
-#endif
-
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -19,17 +17,36 @@
 
 namespace genetic_tetris {
 
-Tetris::Tetris(bool disable_drop_scores)
-    : score_(0),
+namespace {
+
+/// Every game gets 2^32 revisions of its own
+const unsigned int REVISION_BASE_SHIFT = 32;
+std::atomic<std::uint64_t> next_revision_base(1);
+
+int countBits(unsigned int bits) {
+    int count = 0;
+    for (; bits != 0; bits &= bits - 1) {
+        ++count;
+    }
+    return count;
+}
+
+}  // namespace
+
+Tetris::Tetris(bool disable_drop_scores, std::uint64_t seed)
+    : generator_(seed),
+      score_(0),
       level_(1),
       level_progress_(0),
       level_speed_(1),
       cleared_rows_(0),
       drop_scores_disabled_(disable_drop_scores) {
-    for (int i = 0; i < GRID_FULL_HEIGHT; ++i) {
-        std::vector<Tetromino::Color> grid_line(GRID_WIDTH, Tetromino::Color::EMPTY);
-        grid_.push_back(grid_line);
+    occupancy_.fill(0);
+    for (auto& row : colors_) {
+        row.fill(Tetromino::Color::EMPTY);
     }
+    column_heights_.fill(0);
+    holes_ = 0;
     is_finished_ = false;
     // Explicit call (instead of just 'generateTetromino()'), because linter didn't like calling
     // a virtual function from constructor.
@@ -42,6 +59,7 @@ bool Tetris::tick(bool is_soft_drop) {
     if (is_finished_) {
         return false;
     }
+    ++revision_;
     --tetromino_position_.second;
     if (isValidPosition(tetromino_position_)) {
         if (is_soft_drop && !drop_scores_disabled_) {
@@ -50,43 +68,29 @@ bool Tetris::tick(bool is_soft_drop) {
         return false;
     }
     ++tetromino_position_.second;
-    for (const Tetromino::Square& square : tetromino_.getSquares()) {
-        int x = tetromino_position_.first + square.first;
-        int y = tetromino_position_.second + square.second;
-
-        //      The condition below should never evaluate to true and is kinda pointless,
-        //      but I'm leaving it in case somebody changed GRID_VISIBLE_HEIGHT
-        //      and / or GRID_FULL_HEIGHT to some strange values.
-        if (y >= GRID_FULL_HEIGHT) {
-            is_finished_ = true;
-            return false;
-        }
-
-        grid_[y][x] = tetromino_.getColor();
-    }
-
-    clearLines();
-    addClearedLinesScore();
-    addProgress();
-    generateTetromino();
-    return true;
+    return lockTetromino();
 }
 
 void Tetris::shiftLeft() {
     --tetromino_position_.first;
     if (!isValidPosition(tetromino_position_)) {
         ++tetromino_position_.first;
+        return;
     }
+    ++revision_;
 }
 
 void Tetris::shiftRight() {
     ++tetromino_position_.first;
     if (!isValidPosition(tetromino_position_)) {
         --tetromino_position_.first;
+        return;
     }
+    ++revision_;
 }
 
 void Tetris::hardDrop(bool tick_after_drop) {
+    ++revision_;
     int old_y = tetromino_position_.second;
     tetromino_position_ = getHardDropPosition();
     if (!drop_scores_disabled_) {
@@ -97,34 +101,89 @@ void Tetris::hardDrop(bool tick_after_drop) {
     }
 }
 
-void Tetris::rotateCW() { rotate(false); }
+void Tetris::rotateCW() { rotate(1); }
+
+void Tetris::rotateCCW() { rotate(3); }
 
-void Tetris::rotateCCW() { rotate(true); }
+void Tetris::rotate180() { rotate(2); }
 
-Tetris::Grid Tetris::getRawGrid() const { return grid_; }
+bool Tetris::place(int rotation, int column) { return placeTetromino(rotation, column, nullptr); }
+
+bool Tetris::applyPlacement(int rotation, int column, Journal& journal) {
+    return placeTetromino(rotation, column, &journal);
+}
+
+void Tetris::undo(const Journal& journal) {
+    // revision isn't restored, the previous one may have been seen with a different state
+    ++revision_;
+    if (journal.locked) {
+        generator_.returnTetromino(tetromino_, journal.generator_state);
+        for (unsigned int i = 0; i < journal.cleared_rows_count; ++i) {
+            int row = journal.cleared_rows[i];
+            std::copy_backward(occupancy_.begin() + row, occupancy_.end() - 1, occupancy_.end());
+            std::copy_backward(colors_.begin() + row, colors_.end() - 1, colors_.end());
+            occupancy_[row] = FULL_ROW;
+            colors_[row] = journal.cleared_colors[i];
+        }
+        Tetromino placed(journal.tetromino.getShape(), journal.placed_rotation);
+        for (const Tetromino::Square& square : placed.getSquares()) {
+            int x = journal.placed_position.first + square.first;
+            int y = journal.placed_position.second + square.second;
+            occupancy_[y] &= Row(~(1u << x));
+            colors_[y][x] = Tetromino::Color::EMPTY;
+        }
+    }
+    tetromino_ = journal.tetromino;
+    tetromino_position_ = journal.tetromino_position;
+    column_heights_ = journal.column_heights;
+    holes_ = journal.holes;
+    is_finished_ = journal.is_finished;
+    score_ = journal.score;
+    level_ = journal.level;
+    level_progress_ = journal.level_progress;
+    level_speed_ = journal.level_speed;
+    cleared_rows_ = journal.last_cleared_rows;
+}
+
+Tetris::Grid Tetris::getRawGrid() const {
+    Grid grid;
+    grid.reserve(GRID_FULL_HEIGHT);
+    for (const auto& row : colors_) {
+        grid.emplace_back(row.begin(), row.end());
+    }
+    return grid;
+}
+
+Tetris::GridView Tetris::getGridView() const {
+    return GridView(colors_.data(), occupancy_.data());
+}
 
 Tetris::Grid Tetris::getDisplayGrid() const {
     Grid static_grid;
+    getDisplayGrid(static_grid);
+    return static_grid;
+}
+
+void Tetris::getDisplayGrid(Grid& out) const {
+    out.resize(GRID_VISIBLE_HEIGHT);
     for (int i = 0; i < GRID_VISIBLE_HEIGHT; ++i) {
-        std::vector<Tetromino::Color> line(grid_[i]);
-        static_grid.push_back(line);
+        out[i].assign(colors_[i].begin(), colors_[i].end());
     }
     Position ghost_piece_pos = getHardDropPosition();
     for (const Tetromino::Square& square : tetromino_.getSquares()) {
         int x = ghost_piece_pos.first + square.first;
         int y = ghost_piece_pos.second + square.second;
         if (y < GRID_VISIBLE_HEIGHT) {
-            static_grid[y][x] = Tetromino::Color::GHOST;
+            out[y][x] = Tetromino::Color::GHOST;
         }
     }
     for (const Tetromino::Square& square : tetromino_.getSquares()) {
         int x = tetromino_position_.first + square.first;
         int y = tetromino_position_.second + square.second;
         if (y < GRID_VISIBLE_HEIGHT) {
-            static_grid[y][x] = tetromino_.getColor();
+            out[y][x] = tetromino_.getColor();
         }
     }
-    return static_grid;
 }
 
 std::string Tetris::toString() const {
@@ -155,7 +214,21 @@ double Tetris::getLevelSpeed() const { return level_speed_; }
 
 unsigned int Tetris::getLastTickClearedRowsCount() const { return cleared_rows_; }
 
-std::deque<Tetromino> Tetris::getTetrominoQueue() const { return generator_.getQueue(); }
+const std::array<int, Tetris::GRID_WIDTH>& Tetris::getColumnHeights() const {
+    return column_heights_;
+}
+
+int Tetris::getHoles() const { return holes_; }
+
+int Tetris::getRowFillCount(int row) const { return countBits(occupancy_[row]); }
+
+TetrominoGenerator::QueueView Tetris::getTetrominoQueue() const { return generator_.getQueue(); }
+
+std::uint64_t Tetris::getRevision() const { return revision_.get(); }
+
+std::uint64_t Tetris::Revision::nextBase() {
+    return next_revision_base.fetch_add(1, std::memory_order_relaxed) << REVISION_BASE_SHIFT;
+}
 
 bool Tetris::isValidPosition(Position tetromino_position) const {
     const Tetromino::Squares& squares = tetromino_.getSquares();
@@ -165,11 +238,7 @@ bool Tetris::isValidPosition(Position tetromino_position) const {
         if (x < 0 || x > GRID_WIDTH - 1 || y < 0) {
             return false;
         }
-        if (x >= 0 && x < GRID_WIDTH && y >= 0 && y < GRID_FULL_HEIGHT &&
-            grid_[y][x] != Tetromino::Color::EMPTY) {
-            return false;
-        }
-        return true;
+        return y >= GRID_FULL_HEIGHT || (occupancy_[y] & (1u << x)) == 0;
     });
 }
 
@@ -182,26 +251,142 @@ Tetris::Position Tetris::getHardDropPosition() const {
     return drop_pos;
 }
 
-void Tetris::clearLines() {
+bool Tetris::placeTetromino(int rotation, int column, Journal* journal) {
+    if (is_finished_) {
+        return false;
+    }
+    // normalized, so negative rotations don't index rotation tables out of bounds
+    int normalized_rotation =
+        ((rotation % Tetromino::ROTATIONS_COUNT) + Tetromino::ROTATIONS_COUNT) %
+        Tetromino::ROTATIONS_COUNT;
+    Tetromino placed(tetromino_.getShape(), normalized_rotation);
+    // Column heights are never negative, so every square ends up above the floor
+    int landing_y = std::numeric_limits<int>::min();
+    for (const Tetromino::Square& square : placed.getSquares()) {
+        int x = column + square.first;
+        if (x < 0 || x >= GRID_WIDTH) {
+            return false;
+        }
+        landing_y = std::max(landing_y, column_heights_[x] - square.second);
+    }
+    if (journal != nullptr) {
+        journal->tetromino = tetromino_;
+        journal->tetromino_position = tetromino_position_;
+        journal->generator_state = generator_.getState();
+        journal->placed_position = {column, landing_y};
+        journal->placed_rotation = placed.getCurrentRotation();
+        journal->cleared_rows_count = 0;
+        journal->column_heights = column_heights_;
+        journal->holes = holes_;
+        journal->is_finished = is_finished_;
+        journal->score = score_;
+        journal->level = level_;
+        journal->level_progress = level_progress_;
+        journal->level_speed = level_speed_;
+        journal->last_cleared_rows = cleared_rows_;
+    }
     cleared_rows_ = 0;
-    int i = 0;
-    while (i < GRID_FULL_HEIGHT) {
-        bool is_filled_line = true;
-        for (int j = 0; j < GRID_WIDTH; ++j) {
-            if (grid_[i][j] == Tetromino::Color::EMPTY) {
-                is_filled_line = false;
-                break;
-            }
+    ++revision_;
+    int old_y = tetromino_position_.second;
+    tetromino_ = placed;
+    tetromino_position_ = {column, landing_y};
+    if (!drop_scores_disabled_ && old_y > landing_y) {
+        score_ += (old_y - landing_y) * SCORE_HARD_DROP;
+    }
+    bool locked = lockTetromino(journal);
+    if (journal != nullptr) {
+        journal->locked = locked;
+    }
+    return true;
+}
+
+bool Tetris::lockTetromino(Journal* journal) {
+    const Tetromino::Squares& squares = tetromino_.getSquares();
+    //  The condition below should never evaluate to true when dropping from the spawn position,
+    //  but I'm leaving it in case somebody changed GRID_VISIBLE_HEIGHT
+    //  and / or GRID_FULL_HEIGHT to some strange values.
+    if (std::any_of(squares.cbegin(), squares.cend(), [&](const Tetromino::Square& square) {
+            return tetromino_position_.second + square.second >= GRID_FULL_HEIGHT;
+        })) {
+        is_finished_ = true;
+        return false;
+    }
+    int lowest_row = GRID_FULL_HEIGHT;
+    int highest_row = 0;
+    for (const Tetromino::Square& square : squares) {
+        lowest_row = std::min(lowest_row, tetromino_position_.second + square.second);
+        highest_row = std::max(highest_row, tetromino_position_.second + square.second);
+    }
+    // only holes under and inside the rows covered by tetromino can change
+    holes_ -= countHoles(lowest_row - 1, highest_row);
+    for (const Tetromino::Square& square : squares) {
+        int x = tetromino_position_.first + square.first;
+        int y = tetromino_position_.second + square.second;
+        occupancy_[y] |= Row(1u << x);
+        colors_[y][x] = tetromino_.getColor();
+        column_heights_[x] = std::max(column_heights_[x], y + 1);
+    }
+    holes_ += countHoles(lowest_row - 1, highest_row);
+
+    clearLines(lowest_row, highest_row, journal);
+    addClearedLinesScore();
+    addProgress();
+    generateTetromino();
+    return true;
+}
+
+void Tetris::clearLines(int from_row, int to_row, Journal* journal) {
+    cleared_rows_ = 0;
+    // only rows covered by the locked tetromino can become full
+    unsigned int full_rows = 0;
+    for (int y = from_row; y <= to_row; ++y) {
+        if (occupancy_[y] == FULL_ROW) {
+            full_rows |= 1u << (y - from_row);
         }
-        if (is_filled_line) {
-            grid_.erase(grid_.begin() + i);
-            std::vector<Tetromino::Color> grid_line(GRID_WIDTH, Tetromino::Color::EMPTY);
-            grid_.push_back(grid_line);
+    }
+    if (full_rows == 0) {
+        return;
+    }
+    // single compaction pass, rows above the stack are empty and don't need to move
+    int top = *std::max_element(column_heights_.begin(), column_heights_.end());
+    int write = from_row;
+    for (int read = from_row; read < top; ++read) {
+        if (read <= to_row && (full_rows & (1u << (read - from_row))) != 0) {
+            if (journal != nullptr) {
+                journal->cleared_rows[cleared_rows_] = read;
+                journal->cleared_colors[cleared_rows_] = colors_[read];
+                journal->cleared_rows_count = cleared_rows_ + 1;
+            }
             ++cleared_rows_;
-        } else {
-            ++i;
+            continue;
         }
+        if (write != read) {
+            occupancy_[write] = occupancy_[read];
+            colors_[write] = colors_[read];
+        }
+        ++write;
+    }
+    for (int y = write; y < top; ++y) {
+        occupancy_[y] = 0;
+        colors_[y].fill(Tetromino::Color::EMPTY);
+    }
+    for (int x = 0; x < GRID_WIDTH; ++x) {
+        int height = std::max(column_heights_[x] - (int)cleared_rows_, 0);
+        while (height > 0 && (occupancy_[height - 1] & (1u << x)) == 0) {
+            --height;
+        }
+        column_heights_[x] = height;
     }
+    int max_height = *std::max_element(column_heights_.begin(), column_heights_.end());
+    holes_ = countHoles(0, max_height - 1);
+}
+
+int Tetris::countHoles(int from, int to) const {
+    int holes = 0;
+    for (int y = std::max(from, 0); y <= to && y < GRID_FULL_HEIGHT - 1; ++y) {
+        holes += countBits(~occupancy_[y] & occupancy_[y + 1] & FULL_ROW);
+    }
+    return holes;
 }
 
 void Tetris::addClearedLinesScore() {
@@ -238,18 +423,15 @@ void Tetris::calculateLevelSpeed() {
     level_speed_ = speed;
 }
 
-void Tetris::rotate(bool ccw) {
+void Tetris::rotate(int quarter_turns) {
     if (tetromino_.getShape() == Tetromino::Shape::O) {
         return;
     }
+    Tetromino original(tetromino_);
     int from = tetromino_.getCurrentRotation();
-    if (!ccw) {
-        tetromino_.rotateCW();
-    } else {
-        tetromino_.rotateCCW();
-    }
-    int to = tetromino_.getCurrentRotation();
-    std::vector<Position> wall_kicks;
+    int to = (from + quarter_turns) % Tetromino::ROTATIONS_COUNT;
+    tetromino_ = Tetromino(tetromino_.getShape(), to);
+    WallKicks::Kicks wall_kicks;
     if (tetromino_.getShape() == Tetromino::Shape::I) {
         wall_kicks = WallKicks::getITetrominoWallKicks(from, to);
     } else {
@@ -258,19 +440,16 @@ void Tetris::rotate(bool ccw) {
     if (wall_kicks.empty()) {
         throw std::domain_error("Empty wall kick data!");
     }
-    for (const Position& offset : wall_kicks) {
+    for (const WallKicks::Offset& offset : wall_kicks) {
         Position new_pos = {tetromino_position_.first + offset.first,
                             tetromino_position_.second + offset.second};
         if (isValidPosition(new_pos)) {
             tetromino_position_ = new_pos;
+            ++revision_;
             return;
         }
     }
-    if (!ccw) {
-        tetromino_.rotateCCW();
-    } else {
-        tetromino_.rotateCW();
-    }
+    tetromino_ = original;
 }
 
 void Tetris::generateTetromino() {
@@ -4,63 +4,74 @@
 
 #include "tetris/tetromino.hpp"
 
-#ifdef _WIN32
-#define _USE_MATH_DEFINES
-#endif
-
-#include <cmath>
-#include <stdexcept>
-#include <string>
+#include <array>
 #include <utility>
 
 namespace genetic_tetris {
 
-Tetromino::Squares Tetromino::rotate(const Squares& squares, const Pivot& pivot, double rad) {
-    Squares rotated_squares;
-    for (const Square& square : squares) {
-        double x = square.first - pivot.first;
-        double y = square.second - pivot.second;
-        double new_x = x * cos(rad) - y * sin(rad);
-        double new_y = y * cos(rad) + x * sin(rad);
-        Square new_square = std::make_pair(round(new_x + pivot.first), round(new_y + pivot.second));
-        rotated_squares.push_back(new_square);
-    }
-    return rotated_squares;
+namespace {
+
+struct ShapeData {
+    Tetromino::Color color;
+    Tetromino::Rotations rotations;
+};
+
+/**
+ * Rotates square 90 degrees clockwise around (pivot, pivot).
+ * Pivot is passed doubled, so pivots in the middle of a square (e.g. 1.5) stay integers.
+ */
+constexpr Tetromino::Square rotateSquare(const Tetromino::Square& square, int doubled_pivot) {
+    return {square.second, doubled_pivot - square.first};
 }
 
-Tetromino::Tetromino() : color_(Color::EMPTY), shape_(Shape::NO_SHAPE), current_rotation_(0) {}
+constexpr Tetromino::Squares rotateSquares(const Tetromino::Squares& squares, int doubled_pivot) {
+    return {rotateSquare(squares[0], doubled_pivot), rotateSquare(squares[1], doubled_pivot),
+            rotateSquare(squares[2], doubled_pivot), rotateSquare(squares[3], doubled_pivot)};
+}
 
-Tetromino::Tetromino(Color color, Shape shape, Pivot pivot, const Squares& squares)
-    : color_(color), shape_(shape), current_rotation_(0) {
-    rotations_ = {squares};
-    for (int i = 1; i < 4; ++i) {
-        double rad = i * (-M_PI / 2);
-        Squares rotated_squares = rotate(squares, pivot, rad);
-        rotations_.push_back(rotated_squares);
-    }
+constexpr ShapeData makeShape(Tetromino::Color color, int doubled_pivot,
+                              const Tetromino::Squares& squares) {
+    Tetromino::Squares cw = rotateSquares(squares, doubled_pivot);
+    Tetromino::Squares half = rotateSquares(cw, doubled_pivot);
+    Tetromino::Squares ccw = rotateSquares(half, doubled_pivot);
+    return {color, {squares, cw, half, ccw}};
 }
 
-void Tetromino::rotateCW() { current_rotation_ = (current_rotation_ + 1) % 4; }
+/// Indexed by Tetromino::Shape. https://tetris.fandom.com/wiki/SRS
+constexpr std::array<ShapeData, 8> SHAPES = {
+    makeShape(Tetromino::Color::EMPTY, 0, {{{0, 0}, {0, 0}, {0, 0}, {0, 0}}}),
+    makeShape(Tetromino::Color::CYAN, 3, {{{0, 2}, {1, 2}, {2, 2}, {3, 2}}}),
+    makeShape(Tetromino::Color::YELLOW, 3, {{{1, 2}, {2, 2}, {1, 1}, {2, 1}}}),
+    makeShape(Tetromino::Color::PURPLE, 2, {{{0, 1}, {1, 1}, {2, 1}, {1, 2}}}),
+    makeShape(Tetromino::Color::GREEN, 2, {{{0, 1}, {1, 1}, {1, 2}, {2, 2}}}),
+    makeShape(Tetromino::Color::RED, 2, {{{0, 2}, {1, 2}, {1, 1}, {2, 1}}}),
+    makeShape(Tetromino::Color::BLUE, 2, {{{0, 2}, {0, 1}, {1, 1}, {2, 1}}}),
+    makeShape(Tetromino::Color::ORANGE, 2, {{{0, 1}, {1, 1}, {2, 1}, {2, 2}}})};
+
+static_assert(SHAPES[static_cast<int>(Tetromino::Shape::T)].rotations[1][3] ==
+                  Tetromino::Square(2, 1),
+              "T tetromino rotated clockwise should point right");
+
+}  // namespace
+
+void Tetromino::rotateCW() { current_rotation_ = (current_rotation_ + 1) % ROTATIONS_COUNT; }
 
 void Tetromino::rotateCCW() {
     if (current_rotation_ == 0) {
-        current_rotation_ = 3;
+        current_rotation_ = ROTATIONS_COUNT - 1;
     } else {
         --current_rotation_;
     }
 }
 
-Tetromino::Color Tetromino::getColor() const { return color_; }
+Tetromino::Color Tetromino::getColor() const { return SHAPES[static_cast<int>(shape_)].color; }
 
 Tetromino::Shape Tetromino::getShape() const { return shape_; }
 
 const Tetromino::Squares& Tetromino::getSquares() const {
-    if (current_rotation_ % 4 < 0) {
-        throw std::out_of_range("Negative rotation, cannot perform mod operation");
-    }
-    return rotations_[current_rotation_ % 4];
+    return SHAPES[static_cast<int>(shape_)].rotations[current_rotation_];
 }
 
 int Tetromino::getCurrentRotation() const { return current_rotation_; }
 
-}  // namespace genetic_tetris
\ No newline at end of file
+}  // namespace genetic_tetris
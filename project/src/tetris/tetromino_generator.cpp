@@ -4,34 +4,32 @@
 
 #include "tetris/tetromino_generator.hpp"
 
-#include <cstdlib>
-#include <deque>
-#include <vector>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <utility>
 
 #include "tetris/tetromino.hpp"
 
 namespace genetic_tetris {
 
-const std::vector<Tetromino>& TetrominoGenerator::getTetrominoes() {
-    static const std::vector<Tetromino> TETROMINOES = {
-        Tetromino(Tetromino::Color::CYAN, Tetromino::Shape::I, {1.5, 1.5},
-                  {{0, 2}, {1, 2}, {2, 2}, {3, 2}}),
-        Tetromino(Tetromino::Color::BLUE, Tetromino::Shape::J, {1, 1},
-                  {{0, 2}, {0, 1}, {1, 1}, {2, 1}}),
-        Tetromino(Tetromino::Color::ORANGE, Tetromino::Shape::L, {1, 1},
-                  {{0, 1}, {1, 1}, {2, 1}, {2, 2}}),
-        Tetromino(Tetromino::Color::YELLOW, Tetromino::Shape::O, {1.5, 1.5},
-                  {{1, 2}, {2, 2}, {1, 1}, {2, 1}}),
-        Tetromino(Tetromino::Color::GREEN, Tetromino::Shape::S, {1, 1},
-                  {{0, 1}, {1, 1}, {1, 2}, {2, 2}}),
-        Tetromino(Tetromino::Color::PURPLE, Tetromino::Shape::T, {1, 1},
-                  {{0, 1}, {1, 1}, {2, 1}, {1, 2}}),
-        Tetromino(Tetromino::Color::RED, Tetromino::Shape::Z, {1, 1},
-                  {{0, 2}, {1, 2}, {1, 1}, {2, 1}})};
+const std::array<Tetromino, 7>& TetrominoGenerator::getTetrominoes() {
+    static constexpr std::array<Tetromino, 7> TETROMINOES = {
+        Tetromino(Tetromino::Shape::I), Tetromino(Tetromino::Shape::J),
+        Tetromino(Tetromino::Shape::L), Tetromino(Tetromino::Shape::O),
+        Tetromino(Tetromino::Shape::S), Tetromino(Tetromino::Shape::T),
+        Tetromino(Tetromino::Shape::Z)};
     return TETROMINOES;
 }
 
-TetrominoGenerator::TetrominoGenerator() { generateTetrominoes(); }
+std::uint64_t TetrominoGenerator::randomSeed() {
+    std::random_device device;
+    return (static_cast<std::uint64_t>(device()) << 32u) | device();
+}
+
+TetrominoGenerator::TetrominoGenerator(std::uint64_t seed) : random_(seed) {
+    generateTetrominoes();
+}
 
 Tetromino TetrominoGenerator::getNextTetromino() {
     Tetromino next_tetromino = queue_.front();
@@ -42,17 +40,30 @@ Tetromino TetrominoGenerator::getNextTetromino() {
     return next_tetromino;
 }
 
-std::deque<Tetromino> TetrominoGenerator::getQueue() const {
-    return std::deque<Tetromino>(queue_.begin(), queue_.begin() + QUEUE_LENGTH);
+TetrominoGenerator::State TetrominoGenerator::getState() const { return {random_, queue_.size()}; }
+
+void TetrominoGenerator::returnTetromino(const Tetromino& tetromino, const State& state) {
+    // drop the bag generated when the queue got too short
+    while (queue_.size() >= state.queue_size) {
+        queue_.pop_back();
+    }
+    queue_.push_front(tetromino);
+    random_ = state.random;
+}
+
+TetrominoGenerator::QueueView TetrominoGenerator::getQueue() const {
+    return queue_.view(QUEUE_LENGTH);
 }
 
 void TetrominoGenerator::generateTetrominoes() {
     while (queue_.size() < QUEUE_LENGTH) {
-        std::vector<Tetromino> bag(getTetrominoes());
-        while (!bag.empty()) {
-            unsigned int item_idx = rand() % bag.size();
-            queue_.push_back(bag[item_idx]);
-            bag.erase(bag.begin() + item_idx);
+        std::array<Tetromino, 7> bag(getTetrominoes());
+        // Fisher-Yates shuffle
+        for (std::size_t i = bag.size() - 1; i > 0; --i) {
+            std::swap(bag[i], bag[random_.bounded(i + 1)]);
+        }
+        for (const Tetromino& tetromino : bag) {
+            queue_.push_back(tetromino);
         }
     }
 }
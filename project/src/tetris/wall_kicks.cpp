@@ -4,76 +4,134 @@
 
 #include "tetris/wall_kicks.hpp"
 
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <utility>
 
 namespace genetic_tetris::WallKicks {
 
-std::vector<std::pair<int, int> > getGenericWallKicks(int from, int to) {
-    switch (from) {
-        case 0:
-            if (to == 1) {
-                return {{0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2}};
-            } else if (to == 3) {
-                return {{0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2}};
-            }
-            break;
-        case 1:
-            if (to == 2 || to == 0) {
-                return {{0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2}};
-            }
-            break;
-        case 2:
-            if (to == 3) {
-                return {{0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2}};
-            } else if (to == 1) {
-                return {{0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2}};
-            }
-            break;
-        case 3:
-            if (to == 0 || to == 2) {
-                return {{0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2}};
-            }
-            break;
-        default:
-            break;
-    }
-    return {};
+namespace {
+
+const std::size_t MAX_KICKS = 6;
+const std::size_t ROTATIONS = 4;
+const std::size_t PIECE_CLASSES = 2;
+
+struct Entry {
+    std::array<Offset, MAX_KICKS> offsets;
+    std::size_t size;
+};
+
+/// [from][to]
+using Table = std::array<std::array<Entry, ROTATIONS>, ROTATIONS>;
+
+template <std::size_t N, std::size_t... I>
+constexpr Entry makeEntry(const Offset (&offsets)[N], std::index_sequence<I...>) {
+    return {{(I < N ? offsets[I] : Offset())...}, N};
+}
+
+template <std::size_t N>
+constexpr Entry kicks(const Offset (&offsets)[N]) {
+    static_assert(N <= MAX_KICKS, "Too many kicks, increase MAX_KICKS");
+    return makeEntry(offsets, std::make_index_sequence<MAX_KICKS>());
 }
 
-std::vector<std::pair<int, int> > getITetrominoWallKicks(int from, int to) {
-    switch (from) {
-        case 0:
-            if (to == 1) {
-                return {{0, 0}, {-2, 0}, {1, 0}, {-2, -1}, {1, 2}};
-            } else if (to == 3) {
-                return {{0, 0}, {-1, 0}, {2, 0}, {-1, 2}, {2, -1}};
-            }
-            break;
-        case 1:
-            if (to == 2) {
-                return {{0, 0}, {-1, 0}, {2, 0}, {-1, 2}, {2, -1}};
-            } else if (to == 0) {
-                return {{0, 0}, {2, 0}, {-1, 0}, {2, 1}, {-1, -2}};
-            }
-            break;
-        case 2:
-            if (to == 3) {
-                return {{0, 0}, {2, 0}, {-1, 0}, {2, 1}, {-1, -2}};
-            } else if (to == 1) {
-                return {{0, 0}, {1, 0}, {-2, 0}, {1, -2}, {-2, 1}};
-            }
-            break;
-        case 3:
-            if (to == 0) {
-                return {{0, 0}, {1, 0}, {-2, 0}, {1, -2}, {-2, 1}};
-            } else if (to == 2) {
-                return {{0, 0}, {-2, 0}, {1, 0}, {-2, -1}, {1, 2}};
-            }
-            break;
-        default:
-            break;
+constexpr Entry NONE = {};
+
+constexpr Table SRS_GENERIC = {{
+    {NONE, kicks({{0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2}}), kicks({{0, 0}}),
+     kicks({{0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2}})},
+    {kicks({{0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2}}), NONE,
+     kicks({{0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2}}), kicks({{0, 0}})},
+    {kicks({{0, 0}}), kicks({{0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2}}), NONE,
+     kicks({{0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2}})},
+    {kicks({{0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2}}), kicks({{0, 0}}),
+     kicks({{0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2}}), NONE},
+}};
+
+constexpr Table SRS_I = {{
+    {NONE, kicks({{0, 0}, {-2, 0}, {1, 0}, {-2, -1}, {1, 2}}), kicks({{0, 0}}),
+     kicks({{0, 0}, {-1, 0}, {2, 0}, {-1, 2}, {2, -1}})},
+    {kicks({{0, 0}, {2, 0}, {-1, 0}, {2, 1}, {-1, -2}}), NONE,
+     kicks({{0, 0}, {-1, 0}, {2, 0}, {-1, 2}, {2, -1}}), kicks({{0, 0}})},
+    {kicks({{0, 0}}), kicks({{0, 0}, {1, 0}, {-2, 0}, {1, -2}, {-2, 1}}), NONE,
+     kicks({{0, 0}, {2, 0}, {-1, 0}, {2, 1}, {-1, -2}})},
+    {kicks({{0, 0}, {1, 0}, {-2, 0}, {1, -2}, {-2, 1}}), kicks({{0, 0}}),
+     kicks({{0, 0}, {-2, 0}, {1, 0}, {-2, -1}, {1, 2}}), NONE},
+}};
+
+constexpr Entry SRS_PLUS_0_2 = kicks({{0, 0}, {0, 1}, {1, 1}, {-1, 1}, {1, 0}, {-1, 0}});
+constexpr Entry SRS_PLUS_2_0 = kicks({{0, 0}, {0, -1}, {-1, -1}, {1, -1}, {-1, 0}, {1, 0}});
+constexpr Entry SRS_PLUS_1_3 = kicks({{0, 0}, {1, 0}, {1, 2}, {1, 1}, {0, 2}, {0, 1}});
+constexpr Entry SRS_PLUS_3_1 = kicks({{0, 0}, {-1, 0}, {-1, 2}, {-1, 1}, {0, 2}, {0, 1}});
+
+constexpr Table SRS_PLUS_GENERIC = {{
+    {NONE, SRS_GENERIC[0][1], SRS_PLUS_0_2, SRS_GENERIC[0][3]},
+    {SRS_GENERIC[1][0], NONE, SRS_GENERIC[1][2], SRS_PLUS_1_3},
+    {SRS_PLUS_2_0, SRS_GENERIC[2][1], NONE, SRS_GENERIC[2][3]},
+    {SRS_GENERIC[3][0], SRS_PLUS_3_1, SRS_GENERIC[3][2], NONE},
+}};
+
+constexpr Table SRS_PLUS_I = {{
+    {NONE, kicks({{0, 0}, {1, 0}, {-2, 0}, {-2, -1}, {1, 2}}), SRS_PLUS_0_2,
+     kicks({{0, 0}, {-1, 0}, {2, 0}, {-1, 2}, {2, -1}})},
+    {kicks({{0, 0}, {-1, 0}, {2, 0}, {-1, -2}, {2, 1}}), NONE,
+     kicks({{0, 0}, {-1, 0}, {2, 0}, {-1, 2}, {2, -1}}), SRS_PLUS_1_3},
+    {SRS_PLUS_2_0, kicks({{0, 0}, {-2, 0}, {1, 0}, {-2, 1}, {1, -2}}), NONE,
+     kicks({{0, 0}, {2, 0}, {-1, 0}, {2, 1}, {-1, -2}})},
+    {kicks({{0, 0}, {1, 0}, {-2, 0}, {1, -2}, {-2, 1}}), SRS_PLUS_3_1,
+     kicks({{0, 0}, {1, 0}, {-2, 0}, {1, -2}, {-2, 1}}), NONE},
+}};
+
+constexpr Entry ARS_KICK = kicks({{0, 0}, {1, 0}, {-1, 0}});
+constexpr Entry ARS_NO_KICK = kicks({{0, 0}});
+
+constexpr Table ARS_GENERIC = {{
+    {NONE, ARS_KICK, ARS_NO_KICK, ARS_KICK},
+    {ARS_KICK, NONE, ARS_KICK, ARS_NO_KICK},
+    {ARS_NO_KICK, ARS_KICK, NONE, ARS_KICK},
+    {ARS_KICK, ARS_NO_KICK, ARS_KICK, NONE},
+}};
+
+constexpr Table ARS_I = {{
+    {NONE, ARS_NO_KICK, ARS_NO_KICK, ARS_NO_KICK},
+    {ARS_NO_KICK, NONE, ARS_NO_KICK, ARS_NO_KICK},
+    {ARS_NO_KICK, ARS_NO_KICK, NONE, ARS_NO_KICK},
+    {ARS_NO_KICK, ARS_NO_KICK, ARS_NO_KICK, NONE},
+}};
+
+/// [piece class][from][to]
+using KickSystemTable = std::array<Table, PIECE_CLASSES>;
+
+constexpr KickSystemTable SRS = {SRS_GENERIC, SRS_I};
+constexpr KickSystemTable SRS_PLUS = {SRS_PLUS_GENERIC, SRS_PLUS_I};
+constexpr KickSystemTable ARS = {ARS_GENERIC, ARS_I};
+
+Kicks lookup(const KickSystemTable& table, PieceClass piece_class, int from, int to) {
+    if (from < 0 || from >= (int)ROTATIONS || to < 0 || to >= (int)ROTATIONS) {
+        return {};
     }
-    return {};
+    const Entry& entry = table[static_cast<std::size_t>(piece_class)][from][to];
+    return {entry.offsets.data(), entry.size};
+}
+
+}  // namespace
+
+Kicks Srs::get(PieceClass piece_class, int from, int to) {
+    return lookup(SRS, piece_class, from, to);
 }
 
-}  // namespace genetic_tetris::WallKicks
\ No newline at end of file
+Kicks SrsPlus::get(PieceClass piece_class, int from, int to) {
+    return lookup(SRS_PLUS, piece_class, from, to);
+}
+
+Kicks Ars::get(PieceClass piece_class, int from, int to) {
+    return lookup(ARS, piece_class, from, to);
+}
+
+Kicks getGenericWallKicks(int from, int to) {
+    return KickSystem::get(PieceClass::GENERIC, from, to);
+}
+
+Kicks getITetrominoWallKicks(int from, int to) { return KickSystem::get(PieceClass::I, from, to); }
+
+}  // namespace genetic_tetris::WallKicks
@@ -0,0 +1,229 @@
+/*
+ * Author: Damian Kolaska
+ */
+
+#include <rapidjson/ostreamwrapper.h>
+#include <rapidjson/prettywriter.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AI/evolutionary_algo.hpp"
+#include "AI/move.hpp"
+#include "AI/random_number_generator.hpp"
+#include "AI/task_scheduler.hpp"
+#include "tetris/tetris.hpp"
+
+using namespace genetic_tetris;
+
+namespace {
+
+/// Number of seeds used to build the board corpus
+const int CORPUS_SEEDS = 16;
+/// Boards are saved after this many moves of every corpus game
+const std::vector<int> CORPUS_MOVES = {0, 20, 60, 120};
+/// Rotations performed on every board in one run of the rotate benchmark
+const int ROTATIONS_PER_BOARD = 64;
+
+struct Result {
+    std::string name;
+    long long ops;
+    double seconds;
+};
+
+/**
+ * Calls setup() and run() until run() took at least min_seconds in total. Only run() is timed.
+ * run() returns the number of operations it performed.
+ */
+Result measure(const std::string& name, double min_seconds, const std::function<void()>& setup,
+               const std::function<long long()>& run) {
+    using Clock = std::chrono::steady_clock;
+    Result result{name, 0, 0.0};
+    while (result.seconds < min_seconds || result.ops == 0) {
+        setup();
+        auto start = Clock::now();
+        result.ops += run();
+        result.seconds += std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    std::cerr << name << ": " << result.seconds * 1e9 / (double)result.ops << " ns/op" << std::endl;
+    return result;
+}
+
+/// Genome playing corpus games, weights known to play reasonably well
+Genome corpusGenome() { return Genome(0.76f, -0.51f, -0.36f, 0.0f, -0.18f, -0.18f); }
+
+/// Board states from seeded games at different stages, the same on every run
+std::vector<Tetris> makeCorpus() {
+    std::vector<Tetris> corpus;
+    Genome genome = corpusGenome();
+    for (int seed = 1; seed <= CORPUS_SEEDS; seed++) {
+        Tetris tetris(false, (std::uint64_t)seed);
+        int moves = 0;
+        for (int snapshot : CORPUS_MOVES) {
+            for (; moves < snapshot && !tetris.isFinished(); moves++) {
+                EvolutionaryAlgo::generateBestMove(genome, tetris).apply(tetris);
+            }
+            if (!tetris.isFinished()) {
+                corpus.push_back(tetris);
+            }
+        }
+    }
+    return corpus;
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--min-time SECONDS] [--output FILE]\n"
+              << "Runs benchmarks and writes results as JSON to stdout or FILE\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    double min_seconds = 1.0;
+    std::string output;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--min-time" && i + 1 < argc) {
+            min_seconds = std::atof(argv[++i]);
+        } else if (arg == "--output" && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    RandomNumberGenerator::setMasterSeed(0);
+    const std::vector<Tetris> corpus = makeCorpus();
+    const Genome genome = corpusGenome();
+    std::vector<Tetris> boards;
+    auto copy_corpus = [&]() { boards = corpus; };
+    auto nothing = []() {};
+    volatile unsigned long sink = 0;
+
+    std::vector<Result> results;
+    results.push_back(measure("tetris_tick", min_seconds, copy_corpus, [&]() {
+        long long ops = 0;
+        for (auto& tetris : boards) {
+            // tick until the tetromino locks
+            do {
+                ops++;
+            } while (!tetris.tick() && !tetris.isFinished());
+        }
+        return ops;
+    }));
+    results.push_back(measure("tetris_hard_drop", min_seconds, copy_corpus, [&]() {
+        for (auto& tetris : boards) {
+            tetris.hardDrop();
+        }
+        return (long long)boards.size();
+    }));
+    results.push_back(measure("tetris_rotate", min_seconds, copy_corpus, [&]() {
+        for (auto& tetris : boards) {
+            for (int i = 0; i < ROTATIONS_PER_BOARD; i++) {
+                tetris.rotateCW();
+            }
+        }
+        return (long long)boards.size() * ROTATIONS_PER_BOARD;
+    }));
+    // candidates of one pass over the corpus, set by the last run
+    long long applied_candidates = 0;
+    long long rejected_candidates = 0;
+    results.push_back(measure("move_apply_candidate", min_seconds, copy_corpus, [&]() {
+        // what generateBestMove does for every candidate: apply, read properties, undo.
+        // Only applied candidates are ops, time spent rejecting the others is included.
+        long long ops = 0;
+        rejected_candidates = 0;
+        Tetris::Journal journal;
+        for (auto& tetris : boards) {
+            for (int mx = Move::MIN_MOVE; mx <= Move::MAX_MOVE; mx++) {
+                for (int rot = Move::MIN_ROT; rot <= Move::MAX_ROT; rot++) {
+                    Move move(mx, rot);
+                    if (!move.apply(tetris, journal)) {
+                        rejected_candidates++;
+                        continue;
+                    }
+                    ops++;
+                    sink = sink + move.getHoles() + move.getRoughness();
+                    tetris.undo(journal);
+                }
+            }
+        }
+        applied_candidates = ops;
+        return ops;
+    }));
+    results.push_back(measure("grid_properties_scan", min_seconds, nothing, [&]() {
+        Move move;
+        for (const auto& tetris : corpus) {
+            move.calculateGridProperties(tetris.getRawGrid());
+            sink = sink + move.getHoles();
+        }
+        return (long long)corpus.size();
+    }));
+    results.push_back(measure("generate_best_move", min_seconds, copy_corpus, [&]() {
+        for (auto& tetris : boards) {
+            sink = sink + EvolutionaryAlgo::generateBestMove(genome, tetris).getHoles();
+        }
+        return (long long)boards.size();
+    }));
+
+    // one generation of default config with a fixed master seed
+    Tetris unused;
+    EvolutionaryAlgo ai(unused);
+    std::vector<Genome> pop;
+    results.push_back(measure(
+        "evaluation_generation", min_seconds,
+        [&]() {
+            // the same genomes and seeds every time, evaluateOnce() doesn't use the cache
+            RandomNumberGenerator::setMasterSeed(0);
+            pop = std::vector<Genome>(ai.getConfig().pop_size);
+        },
+        [&]() {
+            ai.evaluateOnce(pop);
+            return 1LL;
+        }));
+
+    std::ofstream file;
+    if (!output.empty()) {
+        file.open(output);
+        if (!file) {
+            std::cerr << "Cannot open " << output << std::endl;
+            return 1;
+        }
+    }
+    rapidjson::OStreamWrapper stream(output.empty() ? std::cout : file);
+    rapidjson::PrettyWriter<rapidjson::OStreamWrapper> writer(stream);
+    writer.StartObject();
+    writer.Key("corpus_boards");
+    writer.Int((int)corpus.size());
+    writer.Key("corpus_candidates_applied");
+    writer.Int64(applied_candidates);
+    writer.Key("corpus_candidates_rejected");
+    writer.Int64(rejected_candidates);
+    writer.Key("threads");
+    writer.Uint(TaskScheduler::resolveThreadCount(ai.getConfig().threads));
+    writer.Key("benchmarks");
+    writer.StartArray();
+    for (const auto& result : results) {
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(result.name.c_str());
+        writer.Key("ops");
+        writer.Int64(result.ops);
+        writer.Key("ns_per_op");
+        writer.Double(result.seconds * 1e9 / (double)result.ops);
+        writer.Key("ops_per_sec");
+        writer.Double((double)result.ops / result.seconds);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    (output.empty() ? std::cout : file) << std::endl;
+    return 0;
+}
@@ -2,6 +2,7 @@
  * Author: Damian Kolaska
  */
 
+#include "AI/showcase_player.hpp"
 #include "gui/gui.hpp"
 #include "tetris/tetris.hpp"
 
@@ -11,7 +12,8 @@ int main() {
     sf::Clock clock;
     Tetris tetris;
     EvolutionaryAlgo ai(tetris);
-    GUI gui(800, 900, 60, tetris, tetris, ai);
+    ShowcasePlayer showcase(ai);
+    GUI gui(800, 900, 60, tetris, tetris, ai, showcase);
     gui.setActiveScreen(GUI::ScreenType::GAME);
 
     clock.restart();
@@ -7,7 +7,14 @@
 #define private public
 #include "AI/ai.hpp"
 #include "AI/evolutionary_algo.hpp"
+#include "AI/fitness_cache.hpp"
 #include "AI/genome.hpp"
+#include "AI/random_number_generator.hpp"
+#include "AI/task_scheduler.hpp"
+#include "event_manager.hpp"
+#include "mpsc_queue.hpp"
+#include "seq_lock.hpp"
+#include "triple_buffer.hpp"
 
 using namespace genetic_tetris;
 
@@ -70,4 +77,364 @@ BOOST_AUTO_TEST_CASE(test_move) {
 
 }
 
+BOOST_AUTO_TEST_CASE(test_move_incremental_properties) {
+    std::cout << "Test move properties kept by tetris" << std::endl;
+    Genome genome(0.76f, -0.51f, -0.36f, 0.0f, -0.18f, -0.18f);
+    Tetris tetris(false, 7);
+    for (int i = 0; i < 200 && !tetris.isFinished(); i++) {
+        Move move = EvolutionaryAlgo::generateBestMove(genome, tetris);
+        move.apply(tetris);
+        Move scanned(move);
+        scanned.calculateGridProperties(tetris.getRawGrid());
+        BOOST_REQUIRE(move.getHoles() == scanned.getHoles());
+        BOOST_REQUIRE(move.getMaxHeight() == scanned.getMaxHeight());
+        BOOST_REQUIRE(move.getCumulativeHeight() == scanned.getCumulativeHeight());
+        BOOST_REQUIRE(move.getRelativeHeight() == scanned.getRelativeHeight());
+        BOOST_REQUIRE(move.getRoughness() == scanned.getRoughness());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_task_scheduler_runs_every_task_once) {
+    std::cout << "Test task scheduler" << std::endl;
+    TaskScheduler scheduler(3);
+    for (std::size_t count : {0, 1, 2, 17, 100}) {
+        std::vector<std::atomic<int>> runs(count);
+        scheduler.run(count, [&](std::size_t i) {
+            // uneven task lengths, the first ones are the longest
+            volatile unsigned long sink = 0;
+            for (std::size_t j = 0; j < (count - i) * 1000; j++) sink = sink + j;
+            runs[i]++;
+        });
+        for (const auto& r : runs) {
+            BOOST_REQUIRE(r == 1);
+        }
+        auto stats = scheduler.getLastBatchStats();
+        BOOST_REQUIRE(stats.utilization >= 0.0 && stats.utilization <= 1.0);
+        BOOST_REQUIRE(stats.steals <= count);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_random_number_generator_streams) {
+    std::cout << "Test random number generator streams" << std::endl;
+    auto draw = []() {
+        std::vector<float> values;
+        for (int i = 0; i < 100; i++) {
+            values.push_back(RandomNumberGenerator::getInstance().random<-1, 1>());
+        }
+        return values;
+    };
+    RandomNumberGenerator::setMasterSeed(42);
+    auto first = draw();
+    std::vector<float> other_thread;
+    std::thread([&]() { other_thread = draw(); }).join();
+    RandomNumberGenerator::setMasterSeed(42);
+    BOOST_REQUIRE(draw() == first);
+    BOOST_REQUIRE(other_thread != first);
+    for (float value : first) {
+        BOOST_REQUIRE(value >= -1.0f && value < 1.0f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_score_aggregation) {
+    std::cout << "Test score aggregation" << std::endl;
+    using Aggregation = EvolutionaryAlgo::Aggregation;
+    std::vector<unsigned int> odd = {30, 10, 20};
+    std::vector<unsigned int> even = {40, 10, 30, 20};
+    BOOST_REQUIRE(EvolutionaryAlgo::aggregate(odd, Aggregation::MEAN) == 20.0f);
+    BOOST_REQUIRE(EvolutionaryAlgo::aggregate(odd, Aggregation::MEDIAN) == 20.0f);
+    BOOST_REQUIRE(EvolutionaryAlgo::aggregate(odd, Aggregation::MIN) == 10.0f);
+    BOOST_REQUIRE(EvolutionaryAlgo::aggregate(even, Aggregation::MEAN) == 25.0f);
+    BOOST_REQUIRE(EvolutionaryAlgo::aggregate(even, Aggregation::MEDIAN) == 25.0f);
+    BOOST_REQUIRE(EvolutionaryAlgo::aggregate(even, Aggregation::MIN) == 10.0f);
+}
+
+namespace {
+
+/// Evaluates copy of pop on given seeds and returns it together with the number of pieces played
+std::pair<std::vector<Genome>, std::uint64_t> evaluateRacing(
+    const std::vector<Genome>& pop, const std::vector<std::uint64_t>& seeds,
+    EvolutionaryAlgo::Config config) {
+    Tetris tetris;
+    EvolutionaryAlgo ai(tetris);
+    config.pop_size = pop.size();
+    config.seeds_per_generation = (int)seeds.size();
+    config.fixed_seeds = true;
+    ai.setConfig(config);
+    ai.seeds_ = seeds;
+    ai.scheduler_ = std::make_unique<TaskScheduler>(2);
+    std::vector<Genome> evaluated(pop);
+    ai.evaluation(evaluated);
+    return {evaluated, ai.generation_pieces_.load()};
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(test_racing_single_round_plays_full_games) {
+    std::cout << "Test racing with one round" << std::endl;
+    const std::vector<std::uint64_t> seeds = {11, 12};
+    std::vector<Genome> pop(6);
+    EvolutionaryAlgo::Config config;
+    config.moves_to_simulate = 40;
+    config.racing_rounds = 1;
+    auto [evaluated, pieces] = evaluateRacing(pop, seeds, config);
+
+    Tetris tetris;
+    EvolutionaryAlgo reference(tetris);
+    std::uint64_t expected_pieces = 0;
+    for (std::size_t g = 0; g < pop.size(); g++) {
+        std::vector<unsigned int> scores;
+        for (std::uint64_t seed : seeds) {
+            Tetris game(false, seed);
+            expected_pieces += reference.simulate(pop[g], game, config.moves_to_simulate);
+            scores.push_back(game.getScore());
+        }
+        BOOST_REQUIRE(evaluated[g].score ==
+                      EvolutionaryAlgo::aggregate(scores, config.aggregation));
+    }
+    BOOST_REQUIRE(pieces == expected_pieces);
+}
+
+BOOST_AUTO_TEST_CASE(test_racing_cuts_worst_genomes) {
+    std::cout << "Test racing cuts worst genomes" << std::endl;
+    const std::vector<std::uint64_t> seeds = {21, 22};
+    std::vector<Genome> pop(8);
+    EvolutionaryAlgo::Config config;
+    config.moves_to_simulate = 40;
+    config.racing_rounds = 2;
+    config.racing_cut = 0.5f;
+    auto [evaluated, pieces] = evaluateRacing(pop, seeds, config);
+
+    // replays both rounds: every genome plays half of the moves, the better half plays the rest
+    Tetris tetris;
+    EvolutionaryAlgo reference(tetris);
+    std::vector<std::vector<Tetris>> games(pop.size());
+    std::vector<std::pair<float, std::size_t>> ranking;
+    std::uint64_t expected_pieces = 0;
+    for (std::size_t g = 0; g < pop.size(); g++) {
+        std::vector<unsigned int> scores;
+        for (std::uint64_t seed : seeds) {
+            games[g].emplace_back(false, seed);
+            expected_pieces +=
+                reference.simulate(pop[g], games[g].back(), config.moves_to_simulate / 2);
+            scores.push_back(games[g].back().getScore());
+        }
+        ranking.emplace_back(EvolutionaryAlgo::aggregate(scores, config.aggregation), g);
+    }
+    std::sort(ranking.begin(), ranking.end(), std::greater<>());
+    std::vector<std::size_t> survivors, cut;
+    for (std::size_t r = 0; r < ranking.size(); r++) {
+        (r < pop.size() / 2 ? survivors : cut).push_back(ranking[r].second);
+    }
+    float lowest_survivor = std::numeric_limits<float>::max();
+    for (std::size_t g : survivors) {
+        std::vector<unsigned int> scores;
+        for (Tetris& game : games[g]) {
+            expected_pieces += reference.simulate(pop[g], game, config.moves_to_simulate / 2);
+            scores.push_back(game.getScore());
+        }
+        BOOST_REQUIRE(evaluated[g].score ==
+                      EvolutionaryAlgo::aggregate(scores, config.aggregation));
+        lowest_survivor = std::min(lowest_survivor, evaluated[g].score);
+    }
+    for (std::size_t g : cut) {
+        BOOST_REQUIRE(evaluated[g].score <= lowest_survivor);
+    }
+    BOOST_REQUIRE(pieces == expected_pieces);
+
+    // without racing every game is played to the end
+    config.racing_rounds = 1;
+    auto full = evaluateRacing(pop, seeds, config);
+    BOOST_REQUIRE(pieces < full.second);
+}
+
+BOOST_AUTO_TEST_CASE(test_fitness_cache) {
+    std::cout << "Test fitness cache" << std::endl;
+    FitnessCache cache;
+    Genome genome(0.5f, -0.5f, 0.0f, 0.25f, -1.0f, 1.0f);
+    Genome copy(genome);
+    copy.id++;
+    Genome negative_zero(0.5f, -0.5f, -0.0f, 0.25f, -1.0f, 1.0f);
+    auto seeds_hash = FitnessCache::hashSeeds({1, 2, 3});
+    float fitness = 0.0f;
+    BOOST_REQUIRE(!cache.find(FitnessCache::makeKey(genome, seeds_hash), fitness));
+    cache.insert(FitnessCache::makeKey(genome, seeds_hash), 42.0f);
+    BOOST_REQUIRE(cache.find(FitnessCache::makeKey(copy, seeds_hash), fitness) && fitness == 42.0f);
+    BOOST_REQUIRE(cache.find(FitnessCache::makeKey(negative_zero, seeds_hash), fitness));
+    BOOST_REQUIRE(!cache.find(FitnessCache::makeKey(genome, FitnessCache::hashSeeds({1, 2})),
+                              fitness));
+    copy.holes += 0.1f;
+    BOOST_REQUIRE(!cache.find(FitnessCache::makeKey(copy, seeds_hash), fitness));
+}
+
+BOOST_AUTO_TEST_CASE(test_info_tells_cache_scope) {
+    std::cout << "Test info tells cache scope" << std::endl;
+    EvolutionaryAlgo::Progress progress;
+    progress.cache_lookups = progress.cache_total_lookups = 10;
+    progress.cache_hits = progress.cache_total_hits = 2;
+    const std::string within_generation = "within generation only";
+    BOOST_REQUIRE(EvolutionaryAlgo::formatInfo(progress).find(within_generation) !=
+                  std::string::npos);
+    progress.fixed_seeds = true;
+    BOOST_REQUIRE(EvolutionaryAlgo::formatInfo(progress).find(within_generation) ==
+                  std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_seq_lock_reads_are_not_torn) {
+    std::cout << "Test seq lock" << std::endl;
+    struct Snapshot {
+        std::uint64_t values[9];
+    };
+    SeqLock<Snapshot> lock(Snapshot{});
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (std::uint64_t i = 1; i <= 100000; i++) {
+            Snapshot snapshot;
+            std::fill(std::begin(snapshot.values), std::end(snapshot.values), i);
+            lock.store(snapshot);
+        }
+        done = true;
+    });
+    std::uint64_t last = 0;
+    while (!done) {
+        Snapshot snapshot = lock.load();
+        for (std::uint64_t value : snapshot.values) {
+            BOOST_REQUIRE(value == snapshot.values[0]);
+        }
+        BOOST_REQUIRE(snapshot.values[0] >= last);
+        last = snapshot.values[0];
+    }
+    writer.join();
+    BOOST_REQUIRE(lock.load().values[8] == 100000);
+}
+
+BOOST_AUTO_TEST_CASE(test_triple_buffer_passes_newest_value) {
+    std::cout << "Test triple buffer" << std::endl;
+    TripleBuffer<int> buffer(0);
+    BOOST_REQUIRE(!buffer.consume());
+    buffer.writeBuffer() = 1;
+    buffer.publish();
+    buffer.writeBuffer() = 2;
+    buffer.publish();
+    BOOST_REQUIRE(buffer.consume() && buffer.readBuffer() == 2);
+    BOOST_REQUIRE(!buffer.consume() && buffer.readBuffer() == 2);
+
+    std::thread producer([&]() {
+        for (int i = 3; i <= 100000; i++) {
+            buffer.writeBuffer() = i;
+            buffer.publish();
+        }
+    });
+    int last = 2;
+    while (last != 100000) {
+        if (buffer.consume()) {
+            BOOST_REQUIRE(buffer.readBuffer() > last);
+            last = buffer.readBuffer();
+        }
+    }
+    producer.join();
+}
+
+BOOST_AUTO_TEST_CASE(test_mpsc_queue_keeps_order_of_every_producer) {
+    std::cout << "Test mpsc queue" << std::endl;
+    MpscQueue<int, 8> full;
+    for (int i = 0; i < 8; i++) {
+        BOOST_REQUIRE(full.push(i));
+    }
+    BOOST_REQUIRE(!full.push(8));
+    int value = -1;
+    BOOST_REQUIRE(full.pop(value) && value == 0);
+    BOOST_REQUIRE(full.push(8));
+
+    const int PRODUCERS = 4;
+    const int PUSHES = 20000;
+    MpscQueue<int, 64> queue;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < PUSHES; i++) {
+                while (!queue.push(p * PUSHES + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    std::vector<int> next(PRODUCERS, 0);
+    for (int popped = 0; popped < PRODUCERS * PUSHES;) {
+        if (queue.pop(value)) {
+            BOOST_REQUIRE(value % PUSHES == next[value / PUSHES]);
+            next[value / PUSHES]++;
+            popped++;
+        }
+    }
+    BOOST_REQUIRE(!queue.pop(value));
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_event_manager_queues_only_for_consumer) {
+    std::cout << "Test event manager" << std::endl;
+    EventManager& event_manager = EventManager::getInstance();
+    Event event{};
+    BOOST_REQUIRE(!event_manager.addEvent(EventType::GENOMES_SAVED));
+    BOOST_REQUIRE(!event_manager.pollEvent(event));
+
+    event_manager.setConsumerAttached(true);
+    BOOST_REQUIRE(event_manager.addEvent(EventType::GENERATION_FINISHED, 7));
+    BOOST_REQUIRE(event_manager.pollEvent(event));
+    BOOST_REQUIRE(event.type == EventType::GENERATION_FINISHED && event.payload == 7);
+    for (std::size_t i = 0; i < EventManager::CAPACITY; i++) {
+        BOOST_REQUIRE(event_manager.addEvent(EventType::GENOMES_SAVED));
+    }
+    BOOST_REQUIRE(!event_manager.addEvent(EventType::GENOMES_SAVED));
+    BOOST_REQUIRE(event_manager.getDroppedCount() == 1);
+    while (event_manager.pollEvent(event)) {
+    }
+    event_manager.setConsumerAttached(false);
+}
+
+BOOST_AUTO_TEST_CASE(test_mosaic_snapshots_published_only_when_enabled) {
+    std::cout << "Test mosaic snapshots" << std::endl;
+    EvolutionaryAlgo::Config config;
+    config.pop_size = 4;
+    // a few pieces can clear at most one row, so some squares stay on the board
+    config.moves_to_simulate = 3;
+    config.seeds_per_generation = 2;
+    for (bool enabled : {false, true}) {
+        Tetris tetris;
+        EvolutionaryAlgo ai(tetris);
+        ai.setConfig(config);
+        ai.setMosaicEnabled(enabled);
+        ai.scheduler_ = std::make_unique<TaskScheduler>(2);
+        std::vector<Genome> pop(config.pop_size);
+        ai.evaluation(pop);
+        BOOST_REQUIRE(ai.getMosaicBoardCount() == config.pop_size);
+        for (std::size_t g = 0; g < ai.getMosaicBoardCount(); g++) {
+            EvolutionaryAlgo::BoardSnapshot snapshot = ai.getBoardSnapshot(g);
+            bool empty = std::all_of(snapshot.rows.begin(), snapshot.rows.end(),
+                                     [](Tetris::Row row) { return row == 0; });
+            BOOST_REQUIRE(empty != enabled);
+            BOOST_REQUIRE(!snapshot.playing);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_publish_progress_keeps_random_stream) {
+    std::cout << "Test publish progress keeps random stream" << std::endl;
+    RandomNumberGenerator& generator = RandomNumberGenerator::getInstance();
+    Tetris tetris;
+    EvolutionaryAlgo ai(tetris);
+    ai.best_ = Genome(0.5f, -0.25f, 0.125f, -1.0f, 0.75f, -0.5f);
+    ai.best_.score = 42.0f;
+    RandomNumberGenerator::setMasterSeed(7);
+    long next_id = Genome::next_id;
+    ai.publishProgress(0.0, 0.0, 0.0);
+    Genome best = ai.getBest();
+    float after_publish = generator.random_0_1();
+    RandomNumberGenerator::setMasterSeed(7);
+    BOOST_REQUIRE(generator.random_0_1() == after_publish);
+    BOOST_REQUIRE(Genome::next_id == next_id);
+    BOOST_REQUIRE(best == ai.best_ && best.id == ai.best_.id && best.score == ai.best_.score);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
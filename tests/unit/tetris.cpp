@@ -2,13 +2,18 @@
  * Author: Rafal Kulus
  */
 
+#include <algorithm>
 #include <boost/test/unit_test.hpp>
+#include <cstdint>
 #include <deque>
 #include <iostream>
+#include <string>
 #include <vector>
 
 #include "tetris/tetris.hpp"
 #include "tetris/tetromino.hpp"
+#include "tetris/tetromino_generator.hpp"
+#include "tetris/wall_kicks.hpp"
 
 using namespace genetic_tetris;
 
@@ -51,4 +56,169 @@ BOOST_AUTO_TEST_CASE(tetris_default_config) {
     BOOST_REQUIRE(tetris.getRawGrid() != grid);
 }
 
+BOOST_AUTO_TEST_CASE(tetris_grid_accessors_agree) {
+    std::cout << "Test: Grid view and display grid written in place match copied grids...\n";
+    Tetris tetris(false, 11);
+    Tetris::Grid display(1, std::vector<Tetromino::Color>(3, Tetromino::Color::RED));
+    for (int i = 0; i < 20 && !tetris.isFinished(); ++i) {
+        tetris.hardDrop();
+        Tetris::Grid raw = tetris.getRawGrid();
+        Tetris::GridView view = tetris.getGridView();
+        for (int y = 0; y < Tetris::GridView::height(); ++y) {
+            for (int x = 0; x < Tetris::GridView::width(); ++x) {
+                BOOST_REQUIRE(view[y][x] == raw[y][x]);
+                BOOST_REQUIRE(view.isOccupied(x, y) == (raw[y][x] != Tetromino::Color::EMPTY));
+            }
+        }
+        tetris.getDisplayGrid(display);
+        BOOST_REQUIRE(display == tetris.getDisplayGrid());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(tetris_rotations_round_trip) {
+    std::cout << "Test: Rotating by 360deg in the open returns tetromino to its position...\n";
+    Tetris tetris;
+    std::string initial = tetris.toString();
+    for (int i = 0; i < 4; ++i) {
+        tetris.rotateCW();
+    }
+    BOOST_REQUIRE(tetris.toString() == initial);
+    for (int i = 0; i < 4; ++i) {
+        tetris.rotateCCW();
+    }
+    BOOST_REQUIRE(tetris.toString() == initial);
+    tetris.rotate180();
+    tetris.rotate180();
+    BOOST_REQUIRE(tetris.toString() == initial);
+}
+
+BOOST_AUTO_TEST_CASE(tetris_place_matches_simulated_drop) {
+    std::cout << "Test: Placing a tetromino directly gives the same result as shifting it...\n";
+    Tetris placed;
+    const int moves = 30;
+    for (int i = 0; i < moves && !placed.isFinished(); ++i) {
+        int rotation = i % 4;
+        int column = i % Tetris::GRID_WIDTH;
+        Tetris::Grid grid = placed.getRawGrid();
+        const auto& spawn_row = grid[Tetris::GRID_VISIBLE_HEIGHT - 5];
+        if (std::any_of(spawn_row.begin(), spawn_row.end(),
+                        [](Tetromino::Color c) { return c != Tetromino::Color::EMPTY; })) {
+            // stack reaches spawn area, shifts could be blocked on the way
+            break;
+        }
+        Tetris simulated(placed);
+        if (!placed.place(rotation, column)) {
+            continue;
+        }
+        for (int r = 0; r < rotation; ++r) {
+            simulated.rotateCW();
+        }
+        for (int x = Tetris::TETROMINO_INITIAL_POS.first; x < column; ++x) {
+            simulated.shiftRight();
+        }
+        for (int x = Tetris::TETROMINO_INITIAL_POS.first; x > column; --x) {
+            simulated.shiftLeft();
+        }
+        simulated.hardDrop();
+        BOOST_REQUIRE(placed.getRawGrid() == simulated.getRawGrid());
+        BOOST_REQUIRE(placed.getScore() == simulated.getScore());
+        BOOST_REQUIRE(placed.isFinished() == simulated.isFinished());
+    }
+    BOOST_REQUIRE(!placed.place(0, Tetris::GRID_WIDTH));
+}
+
+BOOST_AUTO_TEST_CASE(tetris_undo_reverts_placements) {
+    std::cout << "Test: Undoing placements restores previous state of the game...\n";
+    Tetris tetris;
+    std::vector<Tetris> states;
+    std::vector<Tetris::Journal> journals;
+    for (int i = 0; !tetris.isFinished(); ++i) {
+        Tetris::Journal journal;
+        Tetris before(tetris);
+        if (tetris.applyPlacement(i % 4, (i * 3) % Tetris::GRID_WIDTH, journal)) {
+            states.push_back(before);
+            journals.push_back(journal);
+        }
+    }
+    BOOST_REQUIRE(!journals.empty());
+    while (!journals.empty()) {
+        tetris.undo(journals.back());
+        const Tetris& expected = states.back();
+        BOOST_REQUIRE(tetris.getRawGrid() == expected.getRawGrid());
+        BOOST_REQUIRE(tetris.toString() == expected.toString());
+        BOOST_REQUIRE(tetris.getScore() == expected.getScore());
+        BOOST_REQUIRE(tetris.getLevel() == expected.getLevel());
+        BOOST_REQUIRE(tetris.getLevelProgress() == expected.getLevelProgress());
+        BOOST_REQUIRE(tetris.isFinished() == expected.isFinished());
+        BOOST_REQUIRE(tetris.getHoles() == expected.getHoles());
+        BOOST_REQUIRE(tetris.getColumnHeights() == expected.getColumnHeights());
+        BOOST_REQUIRE(tetris.getTetrominoQueue().front().getShape() ==
+                      expected.getTetrominoQueue().front().getShape());
+        journals.pop_back();
+        states.pop_back();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(tetris_revision_changes_with_display_grid) {
+    std::cout << "Test: Revision changes with the game and is never shared by two games...\n";
+    Tetris tetris;
+    Tetris other;
+    BOOST_REQUIRE(tetris.getRevision() != other.getRevision());
+    Tetris copy(tetris);
+    BOOST_REQUIRE(copy.getRevision() != tetris.getRevision());
+    std::uint64_t other_revision = other.getRevision();
+    other = tetris;
+    BOOST_REQUIRE(other.getRevision() != tetris.getRevision());
+    BOOST_REQUIRE(other.getRevision() != other_revision);
+
+    std::uint64_t revision = tetris.getRevision();
+    std::string grid = tetris.toString();
+    for (int i = 0; i < Tetris::GRID_WIDTH; ++i) {
+        tetris.shiftLeft();
+    }
+    // tetromino stopped at the wall at some point, revision changes only if it moved
+    BOOST_REQUIRE(tetris.getRevision() != revision);
+    revision = tetris.getRevision();
+    tetris.shiftLeft();
+    BOOST_REQUIRE(tetris.getRevision() == revision);
+    BOOST_REQUIRE(tetris.toString() != grid);
+
+    tetris.tick();
+    BOOST_REQUIRE(tetris.getRevision() != revision);
+    revision = tetris.getRevision();
+    Tetris::Journal journal;
+    BOOST_REQUIRE(tetris.applyPlacement(0, 3, journal));
+    BOOST_REQUIRE(tetris.getRevision() != revision);
+    revision = tetris.getRevision();
+    tetris.undo(journal);
+    BOOST_REQUIRE(tetris.getRevision() != revision);
+}
+
+BOOST_AUTO_TEST_CASE(tetris_place_normalizes_rotation) {
+    std::cout << "Test: Placement rotation is taken modulo 4, also when negative...\n";
+    for (int rotation = -8; rotation < 8; ++rotation) {
+        Tetris tetris(false, 7);
+        Tetris expected(false, 7);
+        BOOST_REQUIRE(tetris.place(rotation, 3) == expected.place(((rotation % 4) + 4) % 4, 3));
+        BOOST_REQUIRE(tetris.getRawGrid() == expected.getRawGrid());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(tetris_rotate_180_kicks_off_the_floor) {
+    std::cout << "Test: 180deg rotation on the floor kicks only if the kick system has 180deg "
+                 "kicks...\n";
+    bool has_180_kicks =
+        WallKicks::KickSystem::get(WallKicks::PieceClass::GENERIC, 0, 2).size() > 1;
+    for (std::uint64_t seed = 0; seed < 20; ++seed) {
+        Tetromino::Shape shape = TetrominoGenerator(seed).getNextTetromino().getShape();
+        Tetris tetris(false, seed);
+        tetris.hardDrop(false);
+        std::uint64_t revision = tetris.getRevision();
+        // rotated tetromino would stick out of the floor, so it has to be kicked up
+        tetris.rotate180();
+        bool rotated = tetris.getRevision() != revision;
+        BOOST_REQUIRE(rotated == (has_180_kicks && shape != Tetromino::Shape::O));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -3,6 +3,7 @@
  */
 
 #include <boost/test/unit_test.hpp>
+#include <cstdint>
 #include <deque>
 #include <iostream>
 #include <set>
@@ -42,12 +43,14 @@ BOOST_AUTO_TEST_CASE(tetromino_generator_queue) {
     std::cout << "Test: Tetromino generator queue works as expected...\n";
     TetrominoGenerator gen;
     const int rounds = 100;
-    std::deque<Tetromino> queue = gen.getQueue();
+    TetrominoGenerator::QueueView view = gen.getQueue();
+    std::deque<Tetromino> queue(view.begin(), view.end());
     for (int i = 0; i < rounds; ++i) {
         Tetromino tetromino = gen.getNextTetromino();
         BOOST_REQUIRE(tetromino.getShape() == queue.front().getShape());
         queue.pop_front();
-        std::deque<Tetromino> new_queue = gen.getQueue();
+        view = gen.getQueue();
+        std::deque<Tetromino> new_queue(view.begin(), view.end());
         BOOST_REQUIRE(new_queue.size() == TetrominoGenerator::QUEUE_LENGTH);
         BOOST_REQUIRE(queue.size() == new_queue.size() - 1);
         for (unsigned int j = 0; j < queue.size(); ++j) {
@@ -57,6 +60,22 @@ BOOST_AUTO_TEST_CASE(tetromino_generator_queue) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(generator_is_reproducible) {
+    std::cout << "Test: Generators with the same seed produce the same tetrominoes...\n";
+    const std::uint64_t seed = 2021;
+    TetrominoGenerator gen(seed);
+    TetrominoGenerator same_seed_gen(seed);
+    TetrominoGenerator other_seed_gen(seed + 1);
+    const int rounds = 100;
+    bool differs = false;
+    for (int i = 0; i < rounds; ++i) {
+        Tetromino::Shape shape = gen.getNextTetromino().getShape();
+        BOOST_REQUIRE(shape == same_seed_gen.getNextTetromino().getShape());
+        differs = differs || shape != other_seed_gen.getNextTetromino().getShape();
+    }
+    BOOST_REQUIRE(differs);
+}
+
 BOOST_AUTO_TEST_CASE(tetromino_rotation_and_size) {
     std::cout << "Test: All tetrominoes in all positions fit in a 4x4 box and rotate by 360deg...\n";
     for (Tetromino tetromino : TetrominoGenerator::getTetrominoes()) {
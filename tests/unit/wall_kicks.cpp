@@ -0,0 +1,103 @@
+/*
+ * Author: Rafal Kulus
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+#include "tetris/wall_kicks.hpp"
+
+using namespace genetic_tetris;
+using namespace genetic_tetris::WallKicks;
+
+namespace {
+
+bool kicksEqual(const Kicks& kicks, const std::vector<Offset>& expected) {
+    return std::vector<Offset>(kicks.begin(), kicks.end()) == expected;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(wall_kicks)
+
+BOOST_AUTO_TEST_CASE(wall_kicks_srs_180_does_not_kick) {
+    std::cout << "Test: SRS tests only the initial position for 180deg rotations...\n";
+    for (PieceClass piece_class : {PieceClass::GENERIC, PieceClass::I}) {
+        for (int from = 0; from < 4; ++from) {
+            BOOST_REQUIRE(kicksEqual(Srs::get(piece_class, from, (from + 2) % 4), {{0, 0}}));
+        }
+    }
+    BOOST_REQUIRE(kicksEqual(Srs::get(PieceClass::I, 0, 1),
+                             {{0, 0}, {-2, 0}, {1, 0}, {-2, -1}, {1, 2}}));
+    BOOST_REQUIRE(Srs::get(PieceClass::GENERIC, 0, 0).empty());
+    BOOST_REQUIRE(Srs::get(PieceClass::GENERIC, 0, 4).empty());
+    BOOST_REQUIRE(Srs::get(PieceClass::GENERIC, -1, 0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(wall_kicks_srs_plus_tables) {
+    std::cout << "Test: SRS+ has 180deg kicks and symmetric I kicks...\n";
+    for (PieceClass piece_class : {PieceClass::GENERIC, PieceClass::I}) {
+        BOOST_REQUIRE(kicksEqual(SrsPlus::get(piece_class, 0, 2),
+                                 {{0, 0}, {0, 1}, {1, 1}, {-1, 1}, {1, 0}, {-1, 0}}));
+        BOOST_REQUIRE(kicksEqual(SrsPlus::get(piece_class, 2, 0),
+                                 {{0, 0}, {0, -1}, {-1, -1}, {1, -1}, {-1, 0}, {1, 0}}));
+        BOOST_REQUIRE(kicksEqual(SrsPlus::get(piece_class, 1, 3),
+                                 {{0, 0}, {1, 0}, {1, 2}, {1, 1}, {0, 2}, {0, 1}}));
+        BOOST_REQUIRE(kicksEqual(SrsPlus::get(piece_class, 3, 1),
+                                 {{0, 0}, {-1, 0}, {-1, 2}, {-1, 1}, {0, 2}, {0, 1}}));
+    }
+    // 90deg generic kicks are the same as in SRS
+    for (int from = 0; from < 4; ++from) {
+        for (int to : {(from + 1) % 4, (from + 3) % 4}) {
+            Kicks srs = Srs::get(PieceClass::GENERIC, from, to);
+            BOOST_REQUIRE(kicksEqual(SrsPlus::get(PieceClass::GENERIC, from, to),
+                                     std::vector<Offset>(srs.begin(), srs.end())));
+        }
+    }
+    BOOST_REQUIRE(kicksEqual(SrsPlus::get(PieceClass::I, 0, 1),
+                             {{0, 0}, {1, 0}, {-2, 0}, {-2, -1}, {1, 2}}));
+    BOOST_REQUIRE(kicksEqual(SrsPlus::get(PieceClass::I, 1, 0),
+                             {{0, 0}, {-1, 0}, {2, 0}, {-1, -2}, {2, 1}}));
+    BOOST_REQUIRE(kicksEqual(SrsPlus::get(PieceClass::I, 0, 3),
+                             {{0, 0}, {-1, 0}, {2, 0}, {-1, 2}, {2, -1}}));
+    BOOST_REQUIRE(SrsPlus::get(PieceClass::I, 2, 2).empty());
+}
+
+BOOST_AUTO_TEST_CASE(wall_kicks_ars_tables) {
+    std::cout << "Test: ARS tries right then left, I tetromino doesn't kick...\n";
+    for (int from = 0; from < 4; ++from) {
+        for (int to : {(from + 1) % 4, (from + 3) % 4}) {
+            BOOST_REQUIRE(kicksEqual(Ars::get(PieceClass::GENERIC, from, to),
+                                     {{0, 0}, {1, 0}, {-1, 0}}));
+            BOOST_REQUIRE(kicksEqual(Ars::get(PieceClass::I, from, to), {{0, 0}}));
+        }
+        BOOST_REQUIRE(kicksEqual(Ars::get(PieceClass::GENERIC, from, (from + 2) % 4), {{0, 0}}));
+        BOOST_REQUIRE(kicksEqual(Ars::get(PieceClass::I, from, (from + 2) % 4), {{0, 0}}));
+        BOOST_REQUIRE(Ars::get(PieceClass::GENERIC, from, from).empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(wall_kicks_game_uses_configured_system) {
+    std::cout << "Test: Game kicks come from the kick system chosen in CMake...\n";
+#if defined(GENETIC_TETRIS_KICK_SYSTEM_SRS_PLUS)
+    BOOST_REQUIRE((std::is_same<KickSystem, SrsPlus>::value));
+#elif defined(GENETIC_TETRIS_KICK_SYSTEM_ARS)
+    BOOST_REQUIRE((std::is_same<KickSystem, Ars>::value));
+#else
+    BOOST_REQUIRE((std::is_same<KickSystem, Srs>::value));
+#endif
+    for (int from = 0; from < 4; ++from) {
+        for (int to = 0; to < 4; ++to) {
+            Kicks generic = KickSystem::get(PieceClass::GENERIC, from, to);
+            Kicks i = KickSystem::get(PieceClass::I, from, to);
+            BOOST_REQUIRE(getGenericWallKicks(from, to).begin() == generic.begin());
+            BOOST_REQUIRE(getGenericWallKicks(from, to).size() == generic.size());
+            BOOST_REQUIRE(getITetrominoWallKicks(from, to).begin() == i.begin());
+            BOOST_REQUIRE(getITetrominoWallKicks(from, to).size() == i.size());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()